@@ -0,0 +1,56 @@
+#!/bin/sh
+# Sweeps the benchmark over particle counts, workgroup sizes and present policies
+#   usage: bench.sh [binary] [results directory]
+#
+#   PARTICLES, WORKGROUPS, POLICIES, FRAMES and WARMUP override the sweep. Runs are headless unless
+#   WINDOWED=1, which is the only way the present policies mean anything (xvfb-run works for lavapipe).
+#   LAVAPIPE=1 points the loader at Mesa's software driver, for machines without a GPU.
+#   Every run appends to results.jsonl and results.csv in the results directory.
+set -e
+
+BIN="${1:-$HOME/compute}"
+OUT="${2:-bench_results}"
+PARTICLES="${PARTICLES:-65536 499294 1048576}"
+WORKGROUPS="${WORKGROUPS:-64 128 256}"
+FRAMES="${FRAMES:-600}"
+WARMUP="${WARMUP:-60}"
+
+if [ "${WINDOWED:-0}" = 1 ]; then
+    POLICIES="${POLICIES:-latency throughput power_save uncapped}"
+else
+    POLICIES="headless"
+fi
+
+if [ "${LAVAPIPE:-0}" = 1 ]; then
+    for icd in /usr/share/vulkan/icd.d/lvp_icd*.json; do
+        [ -e "$icd" ] || { echo "bench: lavapipe ICD not found" >&2; exit 1; }
+        export VK_ICD_FILENAMES="$icd" VK_DRIVER_FILES="$icd"
+    done
+fi
+
+mkdir -p "$OUT"
+rm -f "$OUT/results.jsonl" "$OUT/results.csv"
+TOTAL=$((WARMUP + FRAMES))
+
+for particles in $PARTICLES; do
+    for workgroup in $WORKGROUPS; do
+        for policy in $POLICIES; do
+            echo "bench: $particles particles, workgroups of $workgroup, $policy"
+
+            if [ "$policy" = headless ]; then
+                export NOVA_HEADLESS="$TOTAL"
+                unset NOVA_PRESENT_POLICY NOVA_FRAME_LIMIT
+            else
+                export NOVA_FRAME_LIMIT="$TOTAL" NOVA_PRESENT_POLICY="$policy"
+                unset NOVA_HEADLESS
+            fi
+
+            NOVA_PARTICLES="$particles" NOVA_WORKGROUP_SIZE="$workgroup" NOVA_FRAME_STATS=0 \
+            NOVA_BENCH="$OUT/results" NOVA_BENCH_WARMUP="$WARMUP" \
+                "$BIN" > "$OUT/run_${particles}_${workgroup}_${policy}.log" 2>&1 \
+                || echo "bench: run failed, see $OUT/run_${particles}_${workgroup}_${policy}.log" >&2
+        done
+    done
+done
+
+echo "bench: results in $OUT/results.jsonl and $OUT/results.csv"
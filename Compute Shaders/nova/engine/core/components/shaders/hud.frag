@@ -0,0 +1,19 @@
+#version 450
+
+layout(location = 0) in vec2 cell;
+layout(location = 1) flat in uint frag_glyph;
+layout(location = 2) in vec4 frag_color;
+
+layout(location = 0) out vec4 out_color;
+
+// The glyph is a 3x5 bitmap, bit 14 is the top left cell
+void main() {
+    uint column = min(uint(cell.x), 2u);
+    uint row = min(uint(cell.y), 4u);
+
+    if ((frag_glyph & (1u << (14u - (row * 3u + column)))) == 0u) {
+        discard;
+    }
+
+    out_color = frag_color;
+}
@@ -0,0 +1,34 @@
+#version 450
+
+// One HudQuad per instance, the six corners come from the vertex index
+layout(location = 0) in vec4 rect;
+layout(location = 1) in uint glyph;
+layout(location = 2) in uint color;
+
+layout(location = 0) out vec2 cell;
+layout(location = 1) flat out uint frag_glyph;
+layout(location = 2) out vec4 frag_color;
+
+layout(push_constant) uniform HudPush {
+    vec2 extent;
+} hud;
+
+vec2 corners[6] = vec2[] (
+    vec2(0.0, 0.0),
+    vec2(1.0, 0.0),
+    vec2(0.0, 1.0),
+    vec2(1.0, 0.0),
+    vec2(1.0, 1.0),
+    vec2(0.0, 1.0)
+);
+
+void main()
+{
+    vec2 corner = corners[gl_VertexIndex];
+    vec2 pixel = rect.xy + corner * rect.zw;
+
+    gl_Position = vec4(pixel / hud.extent * 2.0 - 1.0, 0.0, 1.0);
+    cell = corner * vec2(3.0, 5.0);
+    frag_glyph = glyph;
+    frag_color = unpackUnorm4x8(color);
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include "../utility/hash.h"
+
+// A compiled SPIR-V module embedded into the binary by shader_compute.sh
+struct ShaderBlob 
+    {
+        const char* file;       // name of the .spv in the override directory
+        const uint32_t* words;
+        size_t count;
+        uint64_t hash;
+    };
+
+// Point this at a directory of .spv files to load them in place of the embedded words
+const char* const SHADER_OVERRIDE_ENV = "NOVA_SHADER_DIR";
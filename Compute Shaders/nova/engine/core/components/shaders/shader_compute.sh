@@ -1,3 +1,38 @@
-glslc ~/z/Ancillary/Big\ Stick\ Studios/repos/learning/Cpp/Vulkan/Compute\ Shaders/nova/engine/core/components/shaders/sq1.vert -o ~/z/Ancillary/Big\ Stick\ Studios/repos/learning/Cpp/Vulkan/Compute\ Shaders/nova/engine/core/components/shaders/sq1_v.spv
-glslc ~/z/Ancillary/Big\ Stick\ Studios/repos/learning/Cpp/Vulkan/Compute\ Shaders/nova/engine/core/components/shaders/sq1.frag -o ~/z/Ancillary/Big\ Stick\ Studios/repos/learning/Cpp/Vulkan/Compute\ Shaders/nova/engine/core/components/shaders/sq1_f.spv
-glslc ~/z/Ancillary/Big\ Stick\ Studios/repos/learning/Cpp/Vulkan/Compute\ Shaders/nova/engine/core/components/shaders/sq1.comp -o ~/z/Ancillary/Big\ Stick\ Studios/repos/learning/Cpp/Vulkan/Compute\ Shaders/nova/engine/core/components/shaders/sq1_c.spv
\ No newline at end of file
+#!/bin/sh
+# Compiles every shader in the shader directory and embeds the SPIR-V into a generated header
+#   usage: shader_compute.sh [shader directory] [output header]
+set -e
+
+SHADER_DIR="${1:-$(dirname "$0")}"
+HEADER="${2:-$SHADER_DIR/spirv.h}"
+SPV_DIR="$SHADER_DIR/spv"
+
+mkdir -p "$SPV_DIR"
+
+{
+    echo "// Generated by shader_compute.sh - do not edit"
+    echo "#pragma once"
+    echo "#include \"shader_blob.h\""
+    echo ""
+    echo "namespace spirv {"
+
+    for src in "$SHADER_DIR"/*.vert "$SHADER_DIR"/*.frag "$SHADER_DIR"/*.comp; do
+        [ -e "$src" ] || continue
+
+        file=$(basename "$src")
+        spv="$SPV_DIR/$file.spv"
+        glslc "$src" -o "$spv"
+
+        # sq1.comp -> sq1_comp, 00_tri_vertices.vert -> _00_tri_vertices_vert
+        name=$(echo "$file" | tr '.-' '__')
+        case "$name" in [0-9]*) name="_$name" ;; esac
+
+        echo ""
+        echo "    inline constexpr uint32_t ${name}_words[] = {"
+        od -An -v -tx4 "$spv" | awk '{ printf "        "; for (i = 1; i <= NF; i++) printf "0x%s, ", $i; printf "\n" }'
+        echo "    };"
+        echo "    inline constexpr ShaderBlob ${name} = { \"$file.spv\", ${name}_words, sizeof(${name}_words) / sizeof(uint32_t), hashWords(${name}_words, sizeof(${name}_words) / sizeof(uint32_t)) };"
+    done
+
+    echo "}"
+} > "$HEADER"
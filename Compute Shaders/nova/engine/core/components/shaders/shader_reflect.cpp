@@ -0,0 +1,138 @@
+#include "shader_reflect.h"
+
+#include <unordered_map>
+#include <vector>
+
+// The handful of opcodes and enums needed to size a block, from the SPIR-V specification
+enum SPIRV_OP : uint32_t {
+    OP_DECORATE = 71,
+    OP_MEMBER_DECORATE = 72,
+    OP_TYPE_INT = 21,
+    OP_TYPE_FLOAT = 22,
+    OP_TYPE_VECTOR = 23,
+    OP_TYPE_MATRIX = 24,
+    OP_TYPE_ARRAY = 28,
+    OP_TYPE_STRUCT = 30,
+    OP_TYPE_POINTER = 32,
+    OP_CONSTANT = 43,
+    OP_VARIABLE = 59
+};
+
+constexpr uint32_t SPIRV_MAGIC = 0x07230203;
+constexpr uint32_t SPIRV_HEADER_WORDS = 5;
+constexpr uint32_t STORAGE_CLASS_PUSH_CONSTANT = 9;
+constexpr uint32_t DECORATION_ARRAY_STRIDE = 6;
+constexpr uint32_t DECORATION_MATRIX_STRIDE = 7;
+constexpr uint32_t DECORATION_OFFSET = 35;
+
+struct _Module 
+    {
+        std::unordered_map<uint32_t, std::vector<uint32_t>> types;                  // result id -> opcode and operands
+        std::unordered_map<uint32_t, uint32_t> constants;                           // result id -> low word
+        std::unordered_map<uint32_t, uint32_t> array_strides;
+        std::unordered_map<uint64_t, uint32_t> member_offsets;                      // (struct << 32 | member) -> offset
+        std::unordered_map<uint64_t, uint32_t> matrix_strides;
+    };
+
+static inline uint64_t _memberKey(uint32_t structure, uint32_t member) { return (uint64_t)structure << 32 | member; }
+
+static uint32_t _sizeOf(const _Module& module, uint32_t type_id, uint32_t matrix_stride = 0)
+    {
+        auto _type = module.types.find(type_id);
+        if (_type == module.types.end()) { return 0; }
+
+        const std::vector<uint32_t>& _op = _type->second;
+
+        switch (_op[0])
+            {
+                case OP_TYPE_INT:
+                case OP_TYPE_FLOAT: 
+                    return _op[1] / 8;
+                case OP_TYPE_VECTOR: 
+                    return _sizeOf(module, _op[1]) * _op[2];
+                case OP_TYPE_MATRIX: 
+                    return (matrix_stride ? matrix_stride : _sizeOf(module, _op[1])) * _op[2];
+                case OP_TYPE_ARRAY:
+                    {
+                        auto _stride = module.array_strides.find(type_id);
+                        auto _length = module.constants.find(_op[2]);
+                        uint32_t _element = _stride != module.array_strides.end() ? _stride->second : _sizeOf(module, _op[1]);
+                        return _length != module.constants.end() ? _element * _length->second : 0;
+                    }
+                case OP_TYPE_STRUCT:
+                    {
+                        uint32_t _size = 0;
+                        for (uint32_t m = 1; m < _op.size(); m++)
+                            {
+                                auto _offset = module.member_offsets.find(_memberKey(type_id, m - 1));
+                                auto _stride = module.matrix_strides.find(_memberKey(type_id, m - 1));
+                                uint32_t _member_offset = _offset != module.member_offsets.end() ? _offset->second : _size;
+                                uint32_t _member_stride = _stride != module.matrix_strides.end() ? _stride->second : 0;
+                                uint32_t _end = _member_offset + _sizeOf(module, _op[m], _member_stride);
+                                if (_end > _size) { _size = _end; }
+                            }
+                        return _size;
+                    }
+                default: 
+                    return 0;
+            }
+    }
+
+uint32_t reflectPushConstantSize(const uint32_t* words, size_t count)
+    {
+        if (count < SPIRV_HEADER_WORDS || words[0] != SPIRV_MAGIC) { return 0; }
+
+        _Module _module;
+        uint32_t _push_pointer = 0;
+        std::unordered_map<uint32_t, uint32_t> _pointers;   // pointer type id -> pointee type id
+
+        for (size_t i = SPIRV_HEADER_WORDS; i < count;)
+            {
+                uint32_t _word_ct = words[i] >> 16;
+                uint32_t _opcode = words[i] & 0xffff;
+                if (_word_ct == 0 || i + _word_ct > count) { return 0; }
+
+                const uint32_t* _operands = &words[i + 1];
+
+                switch (_opcode)
+                    {
+                        case OP_DECORATE:
+                            if (_operands[1] == DECORATION_ARRAY_STRIDE) { _module.array_strides[_operands[0]] = _operands[2]; }
+                            break;
+                        case OP_MEMBER_DECORATE:
+                            if (_operands[2] == DECORATION_OFFSET) { _module.member_offsets[_memberKey(_operands[0], _operands[1])] = _operands[3]; }
+                            if (_operands[2] == DECORATION_MATRIX_STRIDE) { _module.matrix_strides[_memberKey(_operands[0], _operands[1])] = _operands[3]; }
+                            break;
+                        case OP_TYPE_INT:
+                        case OP_TYPE_FLOAT:
+                        case OP_TYPE_VECTOR:
+                        case OP_TYPE_MATRIX:
+                        case OP_TYPE_ARRAY:
+                        case OP_TYPE_STRUCT:
+                            {
+                                std::vector<uint32_t> _type = { _opcode };
+                                _type.insert(_type.end(), _operands + 1, _operands + _word_ct - 1);
+                                _module.types[_operands[0]] = _type;
+                                break;
+                            }
+                        case OP_TYPE_POINTER:
+                            _pointers[_operands[0]] = _operands[2];
+                            break;
+                        case OP_CONSTANT:
+                            _module.constants[_operands[1]] = _operands[2];
+                            break;
+                        case OP_VARIABLE:
+                            if (_operands[2] == STORAGE_CLASS_PUSH_CONSTANT) { _push_pointer = _operands[0]; }
+                            break;
+                    }
+
+                i += _word_ct;
+            }
+
+        if (_push_pointer == 0 || _pointers.find(_push_pointer) == _pointers.end()) { return 0; }
+
+        return _sizeOf(_module, _pointers[_push_pointer]);
+    }
+
+uint32_t reflectPushConstantSize(const ShaderBlob& blob)
+    { return reflectPushConstantSize(blob.words, blob.count); }
@@ -0,0 +1,7 @@
+#pragma once
+#include "shader_blob.h"
+
+// Just enough SPIR-V reflection to check host structs against what a module declares.
+// Returns the byte size of the module's push constant block, or 0 if it doesn't have one.
+uint32_t reflectPushConstantSize(const ShaderBlob&);
+uint32_t reflectPushConstantSize(const uint32_t*, size_t);
@@ -1,11 +1,13 @@
 #version 450
 
 layout(location = 0) in vec3 frag_color;
+layout(location = 1) in vec2 frag_corner;
+layout(location = 2) flat in uint frag_quad;
 
 layout(location = 0) out vec4 out_color;
 
 void main() {
-    vec2 coordinate = gl_PointCoord - vec2(0.5);
+    vec2 coordinate = (frag_quad != 0 ? frag_corner : gl_PointCoord) - vec2(0.5);
     float distance = length(coordinate);
     float alpha = 1.0 - distance;
     out_color = vec4(frag_color, alpha);
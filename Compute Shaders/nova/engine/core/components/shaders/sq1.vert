@@ -1,13 +1,38 @@
 #version 450
 
+// Drawn as points the particles come in per vertex, drawn as quads per instance
 layout(location = 0) in vec2 position;
 layout(location = 1) in vec4 color;
+layout(location = 2) in vec2 instance_position;
+layout(location = 3) in vec4 instance_color;
+
+layout(push_constant) uniform Push {
+    vec2 quad_size;
+    uint quads;
+} push;
 
 layout(location = 0) out vec3 frag_color;
+layout(location = 1) out vec2 frag_corner;
+layout(location = 2) flat out uint frag_quad;
+
+// Two counter-clockwise triangles
+const vec2 corners[6] = vec2[](vec2(0.0, 0.0), vec2(0.0, 1.0), vec2(1.0, 1.0),
+                               vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(1.0, 0.0));
 
 void main()
 {
     gl_PointSize = 4.0;
+    frag_quad = push.quads;
+
+    if (push.quads != 0) {
+        vec2 corner = corners[gl_VertexIndex];
+        gl_Position = vec4(instance_position + (corner - 0.5) * push.quad_size, 1.0, 1.0);
+        frag_color = instance_color.rgb;
+        frag_corner = corner;
+        return;
+    }
+
     gl_Position = vec4(position, 1.0, 1.0);
     frag_color = color.rgb;
+    frag_corner = vec2(0.5);
 }
\ No newline at end of file
@@ -0,0 +1,101 @@
+// The particle simulation shared by sq1.comp and sq1_bindless.comp, which only differ in how
+// they reach the particle buffers. Not compiled on its own, shader_compute.sh skips .glsl files.
+
+const vec3 background_color = vec3(0.1, 0.2, 0.3);
+
+struct Particle {
+    vec2 position;
+    vec2 velocity;
+    vec4 color;
+};
+
+// BINDLESS reads and writes through the bindless table's binding 0, every registered storage
+// buffer, picking the two particle buffers by the slots in BindlessParticlePush. Otherwise the
+// particles are bindings 0 and 1 of the compute set and the push block is SimulationParams.
+#ifdef BINDLESS
+layout (std140, set = 0, binding = 0) buffer Particles { Particle particles[]; } buffers[];
+#define PARTICLES_IN buffers[push.particles_in].particles
+#define PARTICLES_OUT buffers[push.particles_out].particles
+#else
+layout (std140, binding = 0) readonly buffer ParticlesIn { Particle particles_in[]; };
+layout (std140, binding = 1) buffer ParticlesOut { Particle particles_out[]; };
+#define PARTICLES_IN particles_in
+#define PARTICLES_OUT particles_out
+#endif
+
+layout (push_constant) uniform Push {
+#ifdef BINDLESS
+    uint particles_in;
+    uint particles_out;
+#endif
+    float deltaTime;
+    float time;
+    uint seed;
+    uint emitter;
+    uint substeps;
+    float disk_speed;
+} push;
+
+// One particle per invocation, the host specializes the workgroup size (ComputePipeline::workgroupSize)
+layout (local_size_x_id = 0) in;
+
+vec4 applyMotionBlur(vec3 background, inout vec2 pixel_location, vec2 disk_velocity, vec4 disk_color){
+    vec2 center = vec2(0.0);
+    vec2 distance_from_center = pixel_location - center;
+    float a = dot(disk_velocity, disk_velocity);
+    float b = dot(disk_velocity, distance_from_center);
+    float c = dot(distance_from_center, distance_from_center) - dot(disk_velocity, disk_velocity) * dot(pixel_location, pixel_location);
+    float d = b * b - a * c;
+
+    if (d < 0.0) {
+        return vec4(background, 1.0);
+    }
+
+    d = sqrt(d);
+    float t1 = max((-b - d) / a, 0.0);
+    float t2 = min((-b + d) / a, 1.0); // let's try delta time here next time
+
+    if (t1 < t2) {
+        vec2 intersection = pixel_location + disk_velocity * t1;
+        float distance = length(intersection - pixel_location);
+        float alpha = 1.0 - smoothstep(0.0, 1.0, distance / pixel_location.x);
+        return vec4(mix(background, disk_color.rgb, alpha), alpha);
+    }
+
+    return vec4(background, 1.0);
+}
+
+vec2 calculateOrbitVelocity(vec2 velocity, vec2 position) {
+    vec2 center = vec2(0.0);
+    vec2 distance_from_center = position - center;
+    vec2 tangent = normalize(vec2(-distance_from_center.y, distance_from_center.x));
+    return tangent * push.disk_speed;
+}
+
+void applyDiskMotionBlur(out vec4 color, inout vec2 pixel_location, vec2 velocity, float step_time) {
+    vec4 transition_color = applyMotionBlur(background_color, pixel_location, velocity, color);
+    color = transition_color * push.deltaTime;
+    pixel_location += velocity * step_time;
+}
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+
+    // The last workgroup runs past the particle count, the buffer's length is the count
+    if (index >= PARTICLES_OUT.length()) { return; }
+
+    Particle p = PARTICLES_IN[index];
+
+    // The orbit is integrated in substeps, the color only blends once per frame
+    uint substeps = max(push.substeps, 1u);
+    float step_time = push.deltaTime / float(substeps);
+
+    for (uint step = 1u; step < substeps; step++) {
+        p.position += calculateOrbitVelocity(p.velocity, p.position) * step_time;
+    }
+
+    vec2 velocity = calculateOrbitVelocity(p.velocity, p.position);
+    applyDiskMotionBlur(p.color, p.position, velocity, step_time);
+
+    PARTICLES_OUT[index] = p;
+}
\ No newline at end of file
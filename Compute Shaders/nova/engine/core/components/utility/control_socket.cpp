@@ -0,0 +1,197 @@
+#include "control_socket.h"
+#include "logger.h"
+
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+ControlSocket::ControlSocket()
+    {
+        _listener = -1;
+        _client_ct = 0;
+    }
+
+ControlSocket::~ControlSocket()
+    { close(); }
+
+bool ControlSocket::open(const char* path, Handler handler)
+    {
+        report(LOGGER::VLINE, "\t .. Opening Control Socket ..");
+
+        sockaddr_un _address = {};
+        _address.sun_family = AF_UNIX;
+        if (strlen(path) >= sizeof(_address.sun_path))
+            {
+                report(LOGGER::ERROR, "ControlSocket - Path %s is Too Long for a Unix Socket ..", path);
+                return false;
+            }
+
+        strncpy(_address.sun_path, path, sizeof(_address.sun_path) - 1);
+
+        // Only ever remove a socket, never a file someone pointed us at by mistake
+        struct stat _existing;
+        if (lstat(path, &_existing) == 0 && S_ISSOCK(_existing.st_mode)) { unlink(path); }
+
+        _listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (_listener < 0)
+            {
+                report(LOGGER::ERROR, "ControlSocket - Could not Create a Socket: %s ..", strerror(errno));
+                return false;
+            }
+
+        // Owner only from the moment it exists, any local user who can connect can stall the device
+        mode_t _umask = umask(0077);
+        bool _bound = bind(_listener, (sockaddr*)&_address, sizeof(_address)) == 0;
+        umask(_umask);
+
+        if (!_bound || listen(_listener, CONTROL_MAX_CLIENTS) != 0)
+            {
+                report(LOGGER::ERROR, "ControlSocket - Could not Listen on %s: %s ..", path, strerror(errno));
+                ::close(_listener);
+                _listener = -1;
+                return false;
+            }
+
+        _path = path;
+        _handler = handler;
+        report(LOGGER::INFO, "ControlSocket - Listening on %s ..", path);
+
+        return true;
+    }
+
+void ControlSocket::close()
+    {
+        if (_listener < 0) { return; }
+
+        report(LOGGER::VLINE, "\t .. Closing Control Socket ..");
+
+        while (_client_ct) { _drop(_client_ct - 1); }
+
+        ::close(_listener);
+        _listener = -1;
+        unlink(_path.c_str());
+
+        return;
+    }
+
+// The listener first, then the clients in the order they connected
+void ControlSocket::poll()
+    {
+        if (_listener < 0) { return; }
+
+        pollfd _fds[CONTROL_MAX_CLIENTS + 1];
+        _fds[0] = { .fd = _listener, .events = POLLIN, .revents = 0 };
+
+        for (uint32_t i = 0; i < _client_ct; i++)
+            { _fds[i + 1] = { .fd = _clients[i].fd, .events = POLLIN, .revents = 0 }; }
+
+        uint32_t _polled = _client_ct;
+        if (::poll(_fds, _polled + 1, 0) <= 0) { return; }
+
+        // Backwards, so dropping a client doesn't shift one that's still to be read
+        for (uint32_t i = _polled; i > 0; i--)
+            {
+                if (_fds[i].revents == 0) { continue; }
+                if (!_read(_clients[i - 1])) { _drop(i - 1); }
+            }
+
+        if (_fds[0].revents & POLLIN) { _accept(); }
+
+        return;
+    }
+
+void ControlSocket::_accept()
+    {
+        int _fd;
+        while ((_fd = accept4(_listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+            {
+                if (_client_ct == CONTROL_MAX_CLIENTS)
+                    {
+                        const char _busy[] = "error too many connections\n";
+                        send(_fd, _busy, sizeof(_busy) - 1, MSG_NOSIGNAL);
+                        ::close(_fd);
+                        continue;
+                    }
+
+                _clients[_client_ct++] = { .fd = _fd, .length = 0, .discarding = false, .line = {} };
+                report(LOGGER::VERBOSE, "ControlSocket - Client Connected ..");
+            }
+
+        return;
+    }
+
+// Every complete line is handled as it arrives, a partial one waits for the rest
+bool ControlSocket::_read(Client& client)
+    {
+        ssize_t _received = recv(client.fd, client.line + client.length, CONTROL_LINE_LENGTH - client.length, 0);
+
+        if (_received == 0) { return false; }
+        if (_received < 0) { return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR; }
+
+        char* _start = client.line + client.length;
+        char* _end = _start + _received;
+        char* _newline;
+
+        // What's left of a line that was too long, dropped up to and including its newline
+        if (client.discarding)
+            {
+                _newline = (char*)memchr(_start, '\n', _end - _start);
+                if (_newline == nullptr) { return true; }
+
+                client.discarding = false;
+                memmove(_start, _newline + 1, _end - (_newline + 1));
+                _end -= _newline + 1 - _start;
+            }
+
+        client.length = _end - client.line;
+        _start = client.line;
+
+        while ((_newline = (char*)memchr(_start, '\n', _end - _start)) != nullptr)
+            {
+                *_newline = '\0';
+                if (_newline > _start && _newline[-1] == '\r') { _newline[-1] = '\0'; }
+
+                if (*_start != '\0')
+                    {
+                        _reply.clear();
+                        _handler(_start, _reply);
+                        _send(client, _reply);
+                    }
+
+                _start = _newline + 1;
+            }
+
+        client.length = _end - _start;
+        memmove(client.line, _start, client.length);
+
+        if (client.length == CONTROL_LINE_LENGTH)
+            {
+                _send(client, "error line too long");
+                client.length = 0;
+                client.discarding = true;
+            }
+
+        return true;
+    }
+
+// Replies are a line or two, a client that isn't reading loses the rest rather than stalling the frame
+void ControlSocket::_send(Client& client, const std::string& reply)
+    {
+        std::string _line = reply + "\n";
+        send(client.fd, _line.data(), _line.size(), MSG_NOSIGNAL);
+
+        return;
+    }
+
+void ControlSocket::_drop(uint32_t index)
+    {
+        ::close(_clients[index].fd);
+        _clients[index] = _clients[--_client_ct];
+        report(LOGGER::VERBOSE, "ControlSocket - Client Disconnected ..");
+
+        return;
+    }
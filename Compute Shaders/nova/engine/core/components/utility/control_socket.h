@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+
+const uint32_t CONTROL_MAX_CLIENTS = 4;         // connections served at once, more are turned away
+const uint32_t CONTROL_LINE_LENGTH = 256;       // longest command, anything longer is rejected
+
+/*
+    The ControlSocket listens on a Unix domain socket for line based commands, one per line, and
+    answers each with a single line. Nothing runs on its own thread: poll() is called once a frame,
+    checks the listener and every client with one non-blocking poll(2), and hands each complete line
+    to the handler, so whatever a command changes lands between two frames. A quiet socket costs
+    that one system call. A stale socket left at the path by a crashed run is replaced.
+*/
+
+class ControlSocket {
+    public:
+        typedef std::function<void(const char*, std::string&)> Handler;
+
+        ControlSocket();
+        ~ControlSocket();
+
+        bool open(const char*, Handler);
+        bool listening() { return _listener >= 0; }
+        void poll();
+        void close();
+
+    private:
+        struct Client
+            {
+                int fd;
+                uint32_t length;
+                bool discarding;        // past a line that was too long, until its newline
+                char line[CONTROL_LINE_LENGTH];
+            };
+
+        int _listener;
+        std::string _path;
+        Handler _handler;
+        Client _clients[CONTROL_MAX_CLIENTS];
+        uint32_t _client_ct;
+        std::string _reply;
+
+        void _accept();
+        bool _read(Client&);
+        void _send(Client&, const std::string&);
+        void _drop(uint32_t);
+};
@@ -0,0 +1,198 @@
+#include "frame_stats.h"
+#include "logger.h"
+
+#include <cstdio>
+#include <cstring>
+
+static const char* _METRIC_NAMES[] = { "CPU Frame", "GPU Frame", "Fence Wait", "Acquire", "Present" };
+
+    ///////////////
+    // HISTOGRAM //
+    ///////////////
+
+void LatencyHistogram::reset()
+    {
+        memset(_buckets, 0, sizeof(_buckets));
+        _count = 0;
+        _max = 0;
+    }
+
+// Below 2 * HISTOGRAM_SUB_BUCKETS a bucket per microsecond, above that the top 7 bits
+// of the value pick one of HISTOGRAM_SUB_BUCKETS buckets in its power of two
+uint32_t LatencyHistogram::_getBucket(uint64_t us)
+    {
+        if (us < 2 * HISTOGRAM_SUB_BUCKETS) { return static_cast<uint32_t>(us); }
+
+        uint32_t _shift = 63 - __builtin_clzll(us) - 6;
+        if (_shift > HISTOGRAM_SHIFTS) { return HISTOGRAM_BUCKETS - 1; }
+
+        return 2 * HISTOGRAM_SUB_BUCKETS + (_shift - 1) * HISTOGRAM_SUB_BUCKETS + static_cast<uint32_t>((us >> _shift) - HISTOGRAM_SUB_BUCKETS);
+    }
+
+// The middle of the bucket, in microseconds
+double LatencyHistogram::_getValue(uint32_t bucket)
+    {
+        if (bucket < 2 * HISTOGRAM_SUB_BUCKETS) { return bucket; }
+
+        uint32_t _shift = (bucket - 2 * HISTOGRAM_SUB_BUCKETS) / HISTOGRAM_SUB_BUCKETS + 1;
+        uint64_t _sub = (bucket - 2 * HISTOGRAM_SUB_BUCKETS) % HISTOGRAM_SUB_BUCKETS + HISTOGRAM_SUB_BUCKETS;
+
+        return (double)(_sub << _shift) + (double)(1ULL << _shift) / 2.0;
+    }
+
+void LatencyHistogram::record(uint64_t ns)
+    {
+        uint64_t _us = ns / 1000;
+
+        _buckets[_getBucket(_us)]++;
+        _count++;
+        if (ns > _max) { _max = ns; }
+
+        return;
+    }
+
+// In milliseconds, the bucket holding the sample at that fraction of the count
+double LatencyHistogram::percentile(double fraction)
+    {
+        if (_count == 0) { return 0.0; }
+
+        uint64_t _target = static_cast<uint64_t>(fraction * (_count - 1)) + 1;
+        uint64_t _seen = 0;
+
+        for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+            {
+                _seen += _buckets[i];
+                if (_seen >= _target) { return _getValue(i) / 1e3; }
+            }
+
+        return max();
+    }
+
+
+    /////////////////
+    // FRAME STATS //
+    /////////////////
+
+FrameStats::FrameStats()
+    {
+        _stutters[0] = 0;
+        _stutters[1] = 0;
+        _last_tick_ns = 0;
+        _run_start_ns = now();
+        _interval_start_ns = _run_start_ns;
+        _interval_s = 0.0;
+    }
+
+// Nanoseconds on the steady clock since the first call
+uint64_t FrameStats::now()
+    {
+        static const std::chrono::steady_clock::time_point _origin = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _origin).count();
+    }
+
+void FrameStats::record(FRAME_METRIC metric, uint64_t ns)
+    {
+        _total[metric].record(ns);
+        _interval[metric].record(ns);
+        return;
+    }
+
+void FrameStats::tick()
+    {
+        uint64_t _now = now();
+
+        if (_last_tick_ns != 0)
+            {
+                uint64_t _frame_ns = _now - _last_tick_ns;
+                LatencyHistogram& _cpu = _total[METRIC_CPU_FRAME];
+
+                if (_cpu.count() >= STUTTER_WARMUP && _frame_ns / 1e6 > _cpu.percentile(0.5) * STUTTER_FACTOR)
+                    {
+                        _stutters[0]++;
+                        _stutters[1]++;
+                    }
+
+                record(METRIC_CPU_FRAME, _frame_ns);
+            }
+
+        _last_tick_ns = _now;
+
+        if (_interval_s > 0.0 && (_now - _interval_start_ns) / 1e9 >= _interval_s)
+            { log(false); }
+
+        return;
+    }
+
+// Starts the run over, for a benchmark once it's warmed up
+void FrameStats::reset()
+    {
+        for (uint32_t i = 0; i < METRIC_COUNT; i++)
+            {
+                _total[i].reset();
+                _interval[i].reset();
+            }
+
+        _stutters[0] = 0;
+        _stutters[1] = 0;
+        _run_start_ns = now();
+        _interval_start_ns = _run_start_ns;
+
+        return;
+    }
+
+// The interval summary clears itself, the totals are for the end of the run
+void FrameStats::log(bool total)
+    {
+        LatencyHistogram* _histograms = total ? _total : _interval;
+        uint64_t& _stutter_ct = _stutters[total ? 0 : 1];
+        double _elapsed_s = (now() - (total ? _run_start_ns : _interval_start_ns)) / 1e9;
+
+        if (_histograms[METRIC_CPU_FRAME].count() != 0)
+            {
+                report(LOGGER::INFO, "FrameStats - %s: %llu Frames over %.1f s, %llu Stutters ..", total ? "Run" : "Interval",
+                        (unsigned long long)_histograms[METRIC_CPU_FRAME].count(), _elapsed_s, (unsigned long long)_stutter_ct);
+
+                for (uint32_t i = 0; i < METRIC_COUNT; i++)
+                    {
+                        LatencyHistogram& _histogram = _histograms[i];
+                        if (_histogram.count() == 0) { continue; }
+
+                        report(LOGGER::ILINE, "\t%-12s p50 %8.3f  p90 %8.3f  p99 %8.3f  p99.9 %8.3f  max %8.3f ms",
+                                _METRIC_NAMES[i], _histogram.percentile(0.5), _histogram.percentile(0.9),
+                                _histogram.percentile(0.99), _histogram.percentile(0.999), _histogram.max());
+                    }
+            }
+
+        if (total) { return; }
+
+        for (uint32_t i = 0; i < METRIC_COUNT; i++) { _interval[i].reset(); }
+        _stutter_ct = 0;
+        _interval_start_ns = now();
+
+        return;
+    }
+
+// The run's percentiles, max and count per metric as one JSON object, in milliseconds
+std::string FrameStats::json()
+    {
+        std::string _json = "{";
+        char _field[128];
+
+        for (uint32_t i = 0; i < METRIC_COUNT; i++)
+            {
+                LatencyHistogram& _histogram = _total[i];
+                snprintf(_field, sizeof(_field), "%s\"%s\": {", i ? ", " : "", FRAME_METRIC_KEYS[i]);
+                _json += _field;
+
+                for (uint32_t p = 0; p < REPORT_PERCENTILE_COUNT; p++)
+                    {
+                        snprintf(_field, sizeof(_field), "\"%s\": %.4f, ", REPORT_PERCENTILE_KEYS[p], _histogram.percentile(REPORT_PERCENTILES[p]));
+                        _json += _field;
+                    }
+
+                snprintf(_field, sizeof(_field), "\"max\": %.4f, \"count\": %llu}", _histogram.max(), (unsigned long long)_histogram.count());
+                _json += _field;
+            }
+
+        return _json + "}";
+    }
@@ -0,0 +1,93 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+const uint32_t HISTOGRAM_SUB_BUCKETS = 64;      // per power of two, each bucket within 1/64 of its value
+const uint32_t HISTOGRAM_SHIFTS = 26;           // doublings above 128 us, past a minute
+const uint32_t HISTOGRAM_BUCKETS = 2 * HISTOGRAM_SUB_BUCKETS + HISTOGRAM_SHIFTS * HISTOGRAM_SUB_BUCKETS;
+const double STUTTER_FACTOR = 2.0;              // a frame this many times the median is a stutter
+const uint64_t STUTTER_WARMUP = 60;             // frames before the median is trusted
+
+enum FRAME_METRIC {
+    METRIC_CPU_FRAME,                   // one frame start to the next on the render thread
+    METRIC_GPU_FRAME,                   // the graphics command buffer, from its timestamps
+    METRIC_FENCE_WAIT,                  // blocked on the slot's fences
+    METRIC_ACQUIRE,                     // blocked in vkAcquireNextImageKHR
+    METRIC_PRESENT,                     // in vkQueuePresentKHR
+    METRIC_COUNT
+};
+
+// How the benchmark files and the control socket name the metrics and the percentiles they report
+const char* const FRAME_METRIC_KEYS[METRIC_COUNT] = { "cpu_frame", "gpu_frame", "fence_wait", "acquire", "present" };
+const uint32_t REPORT_PERCENTILE_COUNT = 4;
+const double REPORT_PERCENTILES[REPORT_PERCENTILE_COUNT] = { 0.5, 0.9, 0.99, 0.999 };
+const char* const REPORT_PERCENTILE_KEYS[REPORT_PERCENTILE_COUNT] = { "p50", "p90", "p99", "p99_9" };
+
+/*
+    A LatencyHistogram counts microsecond samples in log-linear buckets after HdrHistogram: exact
+    below 128 us, then 64 buckets per doubling, so any percentile is within about 1.6% of the true
+    value at a fixed 14 KB whatever the range. Recording is an increment, percentiles are one pass.
+*/
+
+class LatencyHistogram {
+    public:
+        LatencyHistogram() { reset(); }
+
+        void record(uint64_t);
+        double percentile(double);
+        uint64_t count() { return _count; }
+        double max() { return _max / 1e6; }
+        void reset();
+
+    private:
+        uint64_t _buckets[HISTOGRAM_BUCKETS];
+        uint64_t _count;
+        uint64_t _max;
+
+        static uint32_t _getBucket(uint64_t);
+        static double _getValue(uint32_t);
+};
+
+/*
+    FrameStats keeps a histogram per FRAME_METRIC twice over, one since start up and one since the
+    last summary. tick() is called once a frame, it times the CPU frame, counts a stutter when it runs
+    past STUTTER_FACTOR times the median, and logs and clears the interval every interval_s seconds.
+    FrameTimer times a block into one metric.
+*/
+
+class FrameStats {
+    public:
+        FrameStats();
+
+        static uint64_t now();
+        double seconds() { return now() / 1e9; }
+        void setInterval(double interval_s) { _interval_s = interval_s; }
+        void record(FRAME_METRIC, uint64_t);
+        void tick();
+        void log(bool = false);
+        void reset();
+        LatencyHistogram& histogram(FRAME_METRIC metric) { return _total[metric]; }
+        std::string json();
+        uint64_t stutters() { return _stutters[0]; }
+
+    private:
+        LatencyHistogram _total[METRIC_COUNT];
+        LatencyHistogram _interval[METRIC_COUNT];
+        uint64_t _stutters[2];                  // since start up, since the last summary
+        uint64_t _last_tick_ns;
+        uint64_t _run_start_ns;
+        uint64_t _interval_start_ns;
+        double _interval_s;
+};
+
+class FrameTimer {
+    public:
+        FrameTimer(FrameStats& stats, FRAME_METRIC metric) : _stats(stats), _metric(metric), _start_ns(FrameStats::now()) {}
+        ~FrameTimer() { _stats.record(_metric, FrameStats::now() - _start_ns); }
+
+    private:
+        FrameStats& _stats;
+        FRAME_METRIC _metric;
+        uint64_t _start_ns;
+};
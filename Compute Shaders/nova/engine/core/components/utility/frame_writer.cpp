@@ -0,0 +1,331 @@
+#include "frame_writer.h"
+#include "logger.h"
+#include "trace_recorder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+FrameWriter::FrameWriter()
+    {
+        written.store(0, std::memory_order_relaxed);
+        dropped.store(0, std::memory_order_relaxed);
+        _format = CAPTURE_PPM;
+        _fps = 60;
+        _stream = nullptr;
+        _stream_width = 0;
+        _stream_height = 0;
+        _running = false;
+    }
+
+FrameWriter::~FrameWriter()
+    { stop(); }
+
+void FrameWriter::start(CAPTURE_FORMAT format, std::string path, uint32_t fps)
+    {
+        report(LOGGER::VLINE, "\t .. Starting Frame Writer ..");
+
+        _format = format;
+        _path = path;
+        _fps = fps ? fps : 60;
+        _running = true;
+        _thread = std::thread(&FrameWriter::_run, this);
+
+        return;
+    }
+
+// Never blocks on the writer, a full queue means the frame is dropped and handed straight back
+bool FrameWriter::submit(CaptureFrame frame)
+    {
+        {
+            std::lock_guard<std::mutex> _lock(_mutex);
+
+            if (_running && _queue.size() < MAX_QUEUED)
+                {
+                    _queue.push_back(frame);
+                    _ready.notify_one();
+                    return true;
+                }
+        }
+
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        frame.done->store(true, std::memory_order_release);
+
+        return false;
+    }
+
+// Drains whatever is already queued before the thread exits
+void FrameWriter::stop()
+    {
+        {
+            std::lock_guard<std::mutex> _lock(_mutex);
+            if (!_running) { return; }
+            _running = false;
+        }
+
+        _ready.notify_one();
+        _thread.join();
+
+        if (_stream != nullptr && _stream != stdout)
+            { fclose(_stream); }
+
+        _stream = nullptr;
+
+        report(LOGGER::INFO, "FrameWriter - %llu Frames Written, %llu Dropped ..",
+                (unsigned long long)written.load(std::memory_order_relaxed), (unsigned long long)dropped.load(std::memory_order_relaxed));
+
+        return;
+    }
+
+void FrameWriter::_run()
+    {
+        TraceRecorder::get().nameThread("Frame Writer");
+
+        while (true)
+            {
+                CaptureFrame _frame;
+
+                {
+                    std::unique_lock<std::mutex> _lock(_mutex);
+                    _ready.wait(_lock, [this] { return !_running || !_queue.empty(); });
+
+                    if (_queue.empty()) { return; }
+
+                    _frame = _queue.front();
+                    _queue.pop_front();
+                }
+
+                {
+                    TRACE_SCOPE("FrameWriter::_write");
+                    _write(_frame);
+                }
+
+                _frame.done->store(true, std::memory_order_release);
+            }
+    }
+
+void FrameWriter::_write(const CaptureFrame& frame)
+    {
+        switch (_format)
+            {
+                case CAPTURE_RAW: _writeRaw(frame); break;
+                case CAPTURE_PPM: _writePPM(frame); break;
+                case CAPTURE_PNG: _writePNG(frame); break;
+                case CAPTURE_Y4M: _writeY4M(frame); break;
+            }
+
+        return;
+    }
+
+std::string FrameWriter::_fileName(uint64_t frame, const char* extension)
+    {
+        char _name[32];
+        snprintf(_name, sizeof(_name), "_%06llu.%s", (unsigned long long)frame, extension);
+
+        return _path + _name;
+    }
+
+// Pixel i as RGBA, whichever order the readback came in
+static inline void _getRGBA(const CaptureFrame& frame, size_t i, uint8_t* rgba)
+    {
+        const uint8_t* _px = frame.pixels + i * 4;
+
+        rgba[0] = frame.bgra ? _px[2] : _px[0];
+        rgba[1] = _px[1];
+        rgba[2] = frame.bgra ? _px[0] : _px[2];
+        rgba[3] = _px[3];
+    }
+
+
+    ////////////////////
+    // IMAGE ENCODERS //
+    ////////////////////
+
+void FrameWriter::_writeRaw(const CaptureFrame& frame)
+    {
+        FILE* _file = fopen(_fileName(frame.frame, "rgba").c_str(), "wb");
+        if (_file == nullptr) { report(LOGGER::ERROR, "FrameWriter - Could not open %s ..", _path.c_str()); return; }
+
+        size_t _count = (size_t)frame.width * frame.height;
+        std::vector<uint8_t> _pixels(_count * 4);
+
+        for (size_t i = 0; i < _count; i++)
+            { _getRGBA(frame, i, &_pixels[i * 4]); }
+
+        fwrite(_pixels.data(), 1, _pixels.size(), _file);
+        fclose(_file);
+        written.fetch_add(1, std::memory_order_relaxed);
+
+        return;
+    }
+
+void FrameWriter::_writePPM(const CaptureFrame& frame)
+    {
+        FILE* _file = fopen(_fileName(frame.frame, "ppm").c_str(), "wb");
+        if (_file == nullptr) { report(LOGGER::ERROR, "FrameWriter - Could not open %s ..", _path.c_str()); return; }
+
+        size_t _count = (size_t)frame.width * frame.height;
+        std::vector<uint8_t> _pixels(_count * 3);
+        uint8_t _rgba[4];
+
+        for (size_t i = 0; i < _count; i++)
+            {
+                _getRGBA(frame, i, _rgba);
+                memcpy(&_pixels[i * 3], _rgba, 3);
+            }
+
+        fprintf(_file, "P6\n%u %u\n255\n", frame.width, frame.height);
+        fwrite(_pixels.data(), 1, _pixels.size(), _file);
+        fclose(_file);
+        written.fetch_add(1, std::memory_order_relaxed);
+
+        return;
+    }
+
+static uint32_t _crc32(const uint8_t* data, size_t size, uint32_t crc = 0)
+    {
+        static uint32_t _table[256] = {};
+
+        if (_table[1] == 0)
+            {
+                for (uint32_t n = 0; n < 256; n++)
+                    {
+                        uint32_t _c = n;
+                        for (int k = 0; k < 8; k++) { _c = _c & 1 ? 0xedb88320u ^ (_c >> 1) : _c >> 1; }
+                        _table[n] = _c;
+                    }
+            }
+
+        crc = ~crc;
+        for (size_t i = 0; i < size; i++) { crc = _table[(crc ^ data[i]) & 0xff] ^ (crc >> 8); }
+
+        return ~crc;
+    }
+
+static inline void _putU32(std::vector<uint8_t>& out, uint32_t value)
+    {
+        out.push_back(value >> 24);
+        out.push_back(value >> 16);
+        out.push_back(value >> 8);
+        out.push_back(value);
+    }
+
+static void _writeChunk(FILE* file, const char* type, const std::vector<uint8_t>& data)
+    {
+        std::vector<uint8_t> _chunk;
+        _putU32(_chunk, static_cast<uint32_t>(data.size()));
+        _chunk.insert(_chunk.end(), type, type + 4);
+        _chunk.insert(_chunk.end(), data.begin(), data.end());
+        _putU32(_chunk, _crc32(_chunk.data() + 4, _chunk.size() - 4));
+
+        fwrite(_chunk.data(), 1, _chunk.size(), file);
+    }
+
+// Stored deflate blocks trade file size for an encoder that costs little more than a copy
+void FrameWriter::_writePNG(const CaptureFrame& frame)
+    {
+        FILE* _file = fopen(_fileName(frame.frame, "png").c_str(), "wb");
+        if (_file == nullptr) { report(LOGGER::ERROR, "FrameWriter - Could not open %s ..", _path.c_str()); return; }
+
+        // Scanlines, each led by filter type 0
+        size_t _row_size = (size_t)frame.width * 4 + 1;
+        std::vector<uint8_t> _scanlines(_row_size * frame.height);
+
+        for (uint32_t y = 0; y < frame.height; y++)
+            {
+                _scanlines[y * _row_size] = 0;
+
+                for (uint32_t x = 0; x < frame.width; x++)
+                    { _getRGBA(frame, (size_t)y * frame.width + x, &_scanlines[y * _row_size + 1 + x * 4]); }
+            }
+
+        // zlib stream of stored blocks, at most 65535 bytes each
+        std::vector<uint8_t> _zlib = { 0x78, 0x01 };
+        _zlib.reserve(_scanlines.size() + _scanlines.size() / 65535 * 5 + 16);
+
+        uint32_t _a = 1, _b = 0;
+        size_t _offset = 0;
+        bool _final = false;
+
+        while (!_final)
+            {
+                uint16_t _len = static_cast<uint16_t>(std::min<size_t>(65535, _scanlines.size() - _offset));
+                _final = _offset + _len == _scanlines.size();
+
+                _zlib.push_back(_final ? 1 : 0);
+                _zlib.push_back(_len & 0xff);
+                _zlib.push_back(_len >> 8);
+                _zlib.push_back(~_len & 0xff);
+                _zlib.push_back((~_len >> 8) & 0xff);
+                _zlib.insert(_zlib.end(), _scanlines.begin() + _offset, _scanlines.begin() + _offset + _len);
+
+                for (size_t i = _offset; i < _offset + _len; i++)
+                    {
+                        _a = (_a + _scanlines[i]) % 65521;
+                        _b = (_b + _a) % 65521;
+                    }
+
+                _offset += _len;
+            }
+
+        _putU32(_zlib, (_b << 16) | _a);
+
+        std::vector<uint8_t> _header;
+        _putU32(_header, frame.width);
+        _putU32(_header, frame.height);
+        _header.insert(_header.end(), { 8, 6, 0, 0, 0 });   // 8 bit RGBA, deflate, adaptive filtering, no interlace
+
+        const uint8_t _SIGNATURE[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+        fwrite(_SIGNATURE, 1, sizeof(_SIGNATURE), _file);
+        _writeChunk(_file, "IHDR", _header);
+        _writeChunk(_file, "IDAT", _zlib);
+        _writeChunk(_file, "IEND", {});
+        fclose(_file);
+        written.fetch_add(1, std::memory_order_relaxed);
+
+        return;
+    }
+
+
+    //////////////////
+    // VIDEO STREAM //
+    //////////////////
+
+// BT.601 studio range, planar 4:4:4 so nothing has to be subsampled on this thread
+void FrameWriter::_writeY4M(const CaptureFrame& frame)
+    {
+        if (_stream == nullptr)
+            {
+                _stream = _path == "-" ? stdout : fopen((_path + ".y4m").c_str(), "wb");
+                if (_stream == nullptr) { report(LOGGER::ERROR, "FrameWriter - Could not open %s ..", _path.c_str()); return; }
+
+                _stream_width = frame.width;
+                _stream_height = frame.height;
+                fprintf(_stream, "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C444\n", _stream_width, _stream_height, _fps);
+            }
+
+        // A stream can't change size midway, frames from a resized window are skipped
+        if (frame.width != _stream_width || frame.height != _stream_height)
+            { dropped.fetch_add(1, std::memory_order_relaxed); return; }
+
+        size_t _count = (size_t)frame.width * frame.height;
+        std::vector<uint8_t> _planes(_count * 3);
+        uint8_t _rgba[4];
+
+        for (size_t i = 0; i < _count; i++)
+            {
+                _getRGBA(frame, i, _rgba);
+                int _r = _rgba[0], _g = _rgba[1], _b = _rgba[2];
+
+                _planes[i] = static_cast<uint8_t>(((66 * _r + 129 * _g + 25 * _b + 128) >> 8) + 16);
+                _planes[_count + i] = static_cast<uint8_t>(((-38 * _r - 74 * _g + 112 * _b + 128) >> 8) + 128);
+                _planes[2 * _count + i] = static_cast<uint8_t>(((112 * _r - 94 * _g - 18 * _b + 128) >> 8) + 128);
+            }
+
+        fputs("FRAME\n", _stream);
+        fwrite(_planes.data(), 1, _planes.size(), _stream);
+        fflush(_stream);
+        written.fetch_add(1, std::memory_order_relaxed);
+
+        return;
+    }
@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+enum CAPTURE_FORMAT {
+    CAPTURE_RAW,                        // tightly packed RGBA8, one <path>_<frame>.rgba per capture
+    CAPTURE_PPM,                        // binary P6, alpha dropped
+    CAPTURE_PNG,                        // RGBA8 with stored (uncompressed) deflate blocks, cheap to write
+    CAPTURE_Y4M                         // one 4:4:4 stream at <path>.y4m, or stdout when the path is "-" and the log on stderr
+};
+
+// A finished readback. The pixels stay owned by the caller, who gets them back when done is set.
+struct CaptureFrame
+    {
+        const uint8_t* pixels;
+        uint32_t width;
+        uint32_t height;
+        uint64_t frame;
+        bool bgra;                      // swizzle on the way out, swapchain formats are usually BGRA
+        std::atomic<bool>* done;
+    };
+
+/*
+    The FrameWriter encodes and writes captures on its own thread so the render loop never waits on
+    the disk. The queue is bounded, when the writer falls behind submit() refuses the frame and the
+    caller drops it, trading a gap in the capture for a steady frame rate.
+*/
+
+class FrameWriter {
+    public:
+        std::atomic<uint64_t> written;          // bumped by the writer thread
+        std::atomic<uint64_t> dropped;          // by the render loop and the writer both
+
+        FrameWriter();
+        ~FrameWriter();
+
+        void start(CAPTURE_FORMAT, std::string, uint32_t);
+        bool submit(CaptureFrame);
+        void stop();
+        bool running() { return _running; }
+
+    private:
+        CAPTURE_FORMAT _format;
+        std::string _path;
+        uint32_t _fps;
+        FILE* _stream;
+        uint32_t _stream_width;
+        uint32_t _stream_height;
+
+        std::thread _thread;
+        std::mutex _mutex;
+        std::condition_variable _ready;
+        std::deque<CaptureFrame> _queue;
+        bool _running;
+        const size_t MAX_QUEUED = 4;
+
+        void _run();
+        void _write(const CaptureFrame&);
+        std::string _fileName(uint64_t, const char*);
+        void _writeRaw(const CaptureFrame&);
+        void _writePPM(const CaptureFrame&);
+        void _writePNG(const CaptureFrame&);
+        void _writeY4M(const CaptureFrame&);
+};
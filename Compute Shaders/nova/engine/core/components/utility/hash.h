@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// FNV-1a, constexpr so that generated headers can carry their own digests
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+constexpr uint64_t hashWords(const uint32_t* words, size_t count, uint64_t hash = FNV_OFFSET_BASIS)
+    {
+        for (size_t i = 0; i < count; i++)
+            {
+                for (uint32_t b = 0; b < 4; b++)
+                    {
+                        hash ^= (words[i] >> (b * 8)) & 0xff;
+                        hash *= FNV_PRIME;
+                    }
+            }
+
+        return hash;
+    }
+
+inline uint64_t hashBytes(const void* data, size_t size, uint64_t hash = FNV_OFFSET_BASIS)
+    {
+        const unsigned char* _bytes = static_cast<const unsigned char*>(data);
+
+        for (size_t i = 0; i < size; i++)
+            {
+                hash ^= _bytes[i];
+                hash *= FNV_PRIME;
+            }
+
+        return hash;
+    }
@@ -0,0 +1,144 @@
+#include "hud_canvas.h"
+
+constexpr uint32_t _glyph(uint32_t r0, uint32_t r1, uint32_t r2, uint32_t r3, uint32_t r4)
+    { return r0 << 12 | r1 << 9 | r2 << 6 | r3 << 3 | r4; }
+
+// ASCII 32 to 95, each row three bits with the leftmost column high
+static const uint32_t _FONT[64] = {
+    _glyph(0b000, 0b000, 0b000, 0b000, 0b000),  // space
+    _glyph(0b010, 0b010, 0b010, 0b000, 0b010),  // !
+    _glyph(0b101, 0b101, 0b000, 0b000, 0b000),  // "
+    _glyph(0b101, 0b111, 0b101, 0b111, 0b101),  // #
+    _glyph(0b011, 0b110, 0b010, 0b011, 0b110),  // $
+    _glyph(0b101, 0b001, 0b010, 0b100, 0b101),  // %
+    _glyph(0b010, 0b101, 0b010, 0b101, 0b011),  // &
+    _glyph(0b010, 0b010, 0b000, 0b000, 0b000),  // '
+    _glyph(0b001, 0b010, 0b010, 0b010, 0b001),  // (
+    _glyph(0b100, 0b010, 0b010, 0b010, 0b100),  // )
+    _glyph(0b000, 0b101, 0b010, 0b101, 0b000),  // *
+    _glyph(0b000, 0b010, 0b111, 0b010, 0b000),  // +
+    _glyph(0b000, 0b000, 0b000, 0b010, 0b100),  // ,
+    _glyph(0b000, 0b000, 0b111, 0b000, 0b000),  // -
+    _glyph(0b000, 0b000, 0b000, 0b000, 0b010),  // .
+    _glyph(0b001, 0b001, 0b010, 0b100, 0b100),  // /
+    _glyph(0b111, 0b101, 0b101, 0b101, 0b111),  // 0
+    _glyph(0b010, 0b110, 0b010, 0b010, 0b111),  // 1
+    _glyph(0b111, 0b001, 0b111, 0b100, 0b111),  // 2
+    _glyph(0b111, 0b001, 0b111, 0b001, 0b111),  // 3
+    _glyph(0b101, 0b101, 0b111, 0b001, 0b001),  // 4
+    _glyph(0b111, 0b100, 0b111, 0b001, 0b111),  // 5
+    _glyph(0b111, 0b100, 0b111, 0b101, 0b111),  // 6
+    _glyph(0b111, 0b001, 0b001, 0b001, 0b001),  // 7
+    _glyph(0b111, 0b101, 0b111, 0b101, 0b111),  // 8
+    _glyph(0b111, 0b101, 0b111, 0b001, 0b111),  // 9
+    _glyph(0b000, 0b010, 0b000, 0b010, 0b000),  // :
+    _glyph(0b000, 0b010, 0b000, 0b010, 0b100),  // ;
+    _glyph(0b001, 0b010, 0b100, 0b010, 0b001),  // <
+    _glyph(0b000, 0b111, 0b000, 0b111, 0b000),  // =
+    _glyph(0b100, 0b010, 0b001, 0b010, 0b100),  // >
+    _glyph(0b111, 0b001, 0b011, 0b000, 0b010),  // ?
+    _glyph(0b111, 0b101, 0b111, 0b100, 0b111),  // @
+    _glyph(0b010, 0b101, 0b111, 0b101, 0b101),  // A
+    _glyph(0b110, 0b101, 0b110, 0b101, 0b110),  // B
+    _glyph(0b011, 0b100, 0b100, 0b100, 0b011),  // C
+    _glyph(0b110, 0b101, 0b101, 0b101, 0b110),  // D
+    _glyph(0b111, 0b100, 0b110, 0b100, 0b111),  // E
+    _glyph(0b111, 0b100, 0b110, 0b100, 0b100),  // F
+    _glyph(0b011, 0b100, 0b101, 0b101, 0b011),  // G
+    _glyph(0b101, 0b101, 0b111, 0b101, 0b101),  // H
+    _glyph(0b111, 0b010, 0b010, 0b010, 0b111),  // I
+    _glyph(0b001, 0b001, 0b001, 0b101, 0b010),  // J
+    _glyph(0b101, 0b101, 0b110, 0b101, 0b101),  // K
+    _glyph(0b100, 0b100, 0b100, 0b100, 0b111),  // L
+    _glyph(0b101, 0b111, 0b111, 0b101, 0b101),  // M
+    _glyph(0b110, 0b101, 0b101, 0b101, 0b101),  // N
+    _glyph(0b010, 0b101, 0b101, 0b101, 0b010),  // O
+    _glyph(0b110, 0b101, 0b110, 0b100, 0b100),  // P
+    _glyph(0b010, 0b101, 0b101, 0b110, 0b011),  // Q
+    _glyph(0b110, 0b101, 0b110, 0b101, 0b101),  // R
+    _glyph(0b011, 0b100, 0b010, 0b001, 0b110),  // S
+    _glyph(0b111, 0b010, 0b010, 0b010, 0b010),  // T
+    _glyph(0b101, 0b101, 0b101, 0b101, 0b111),  // U
+    _glyph(0b101, 0b101, 0b101, 0b101, 0b010),  // V
+    _glyph(0b101, 0b101, 0b111, 0b111, 0b101),  // W
+    _glyph(0b101, 0b101, 0b010, 0b101, 0b101),  // X
+    _glyph(0b101, 0b101, 0b010, 0b010, 0b010),  // Y
+    _glyph(0b111, 0b001, 0b010, 0b100, 0b111),  // Z
+    _glyph(0b110, 0b100, 0b100, 0b100, 0b110),  // [
+    _glyph(0b100, 0b100, 0b010, 0b001, 0b001),  // backslash
+    _glyph(0b011, 0b001, 0b001, 0b001, 0b011),  // ]
+    _glyph(0b010, 0b101, 0b000, 0b000, 0b000),  // ^
+    _glyph(0b000, 0b000, 0b000, 0b000, 0b111)   // _
+};
+
+static inline uint32_t _getGlyph(char c)
+    {
+        if (c >= 'a' && c <= 'z') { c = c - 'a' + 'A'; }
+        if (c < ' ' || c > '_') { return _FONT['?' - ' ']; }
+
+        return _FONT[c - ' '];
+    }
+
+float HudSeries::max()
+    {
+        float _max = 0.0f;
+        for (float _value : values) { if (_value > _max) { _max = _value; } }
+
+        return _max;
+    }
+
+void HudCanvas::begin(HudQuad* quads, uint32_t capacity)
+    {
+        _quads = quads;
+        _capacity = capacity;
+        _count = 0;
+
+        return;
+    }
+
+void HudCanvas::_push(float x, float y, float width, float height, uint32_t glyph, uint32_t color)
+    {
+        if (_count == _capacity) { return; }
+
+        _quads[_count++] = { .x = x, .y = y, .width = width, .height = height, .glyph = glyph, .color = color };
+
+        return;
+    }
+
+void HudCanvas::rect(float x, float y, float width, float height, uint32_t color)
+    {
+        _push(x, y, width, height, HUD_SOLID, color);
+        return;
+    }
+
+// Each font cell is scale pixels square with a one cell gap, returns where the next character would go
+float HudCanvas::text(float x, float y, float scale, uint32_t color, const char* string)
+    {
+        for (const char* _c = string; *_c != '\0'; _c++)
+            {
+                uint32_t _glyph_bits = _getGlyph(*_c);
+                if (_glyph_bits != 0) { _push(x, y, HUD_GLYPH_WIDTH * scale, HUD_GLYPH_HEIGHT * scale, _glyph_bits, color); }
+
+                x += (HUD_GLYPH_WIDTH + 1) * scale;
+            }
+
+        return x;
+    }
+
+// One bar per sample, oldest on the left, scaled so ceiling fills the height
+void HudCanvas::graph(float x, float y, float width, float height, HudSeries& series, float ceiling, uint32_t color)
+    {
+        float _bar = width / HUD_GRAPH_SAMPLES;
+        if (ceiling <= 0.0f) { return; }
+
+        for (uint32_t i = 0; i < HUD_GRAPH_SAMPLES; i++)
+            {
+                float _value = series.values[(series.head + i) % HUD_GRAPH_SAMPLES] / ceiling;
+                if (_value <= 0.0f) { continue; }
+                if (_value > 1.0f) { _value = 1.0f; }
+
+                _push(x + i * _bar, y + height * (1.0f - _value), _bar, height * _value, HUD_SOLID, color);
+            }
+
+        return;
+    }
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+
+const uint32_t HUD_GLYPH_WIDTH = 3;             // font cells, every glyph is a 3x5 bitmap
+const uint32_t HUD_GLYPH_HEIGHT = 5;
+const uint32_t HUD_SOLID = 0x7FFF;              // every bit of the cell set, a filled rectangle
+const uint32_t HUD_GRAPH_SAMPLES = 120;         // frames each graph shows
+const uint32_t HUD_MAX_QUADS = 1024;            // instances per frame, the rest are dropped
+const uint32_t HUD_LINES = 8;                   // lines of text and the characters in each
+const uint32_t HUD_LINE_LENGTH = 32;
+
+// One instance of the overlay's draw, in pixels from the top left of the swapchain.
+// Its 15 bit glyph is the bitmap itself, row major from bit 14 at the top left.
+struct HudQuad
+    {
+        float x;
+        float y;
+        float width;
+        float height;
+        uint32_t glyph;
+        uint32_t color;                 // RGBA8, red in the low byte
+    };
+
+constexpr uint32_t hudColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255)
+    { return (uint32_t)r | (uint32_t)g << 8 | (uint32_t)b << 16 | (uint32_t)a << 24; }
+
+// The last HUD_GRAPH_SAMPLES values of something, oldest first from head
+struct HudSeries
+    {
+        float values[HUD_GRAPH_SAMPLES] = {};
+        uint32_t head = 0;
+
+        void push(float value)
+            {
+                values[head] = value;
+                head = (head + 1) % HUD_GRAPH_SAMPLES;
+            }
+
+        float max();
+    };
+
+/*
+    A HudCanvas lays the overlay out as quads written straight into memory it's given, typically a
+    mapped instance buffer, and drops whatever doesn't fit. Text comes from a 3x5 font held as one
+    15 bit mask per glyph for ASCII 32 to 95, lower case is drawn upper case. Nothing allocates.
+*/
+
+class HudCanvas {
+    public:
+        void begin(HudQuad*, uint32_t);
+        uint32_t count() { return _count; }
+
+        void rect(float, float, float, float, uint32_t);
+        float text(float, float, float, uint32_t, const char*);
+        void graph(float, float, float, float, HudSeries&, float, uint32_t);
+
+    private:
+        HudQuad* _quads = nullptr;
+        uint32_t _capacity = 0;
+        uint32_t _count = 0;
+
+        void _push(float, float, float, float, uint32_t, uint32_t);
+};
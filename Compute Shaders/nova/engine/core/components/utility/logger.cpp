@@ -1,44 +1,214 @@
 #include "logger.h"
 
-#include <iostream>
+#include <atomic>
+#include <chrono>
 #include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <thread>
 
+const size_t LOG_RING_SIZE = 1024;             // power of two, the sequence math depends on it
+const size_t LOG_LINE_SIZE = 256;              // longer messages are truncated
 
-static bool letsGo(LOGGER level) {
-    return level <= LOG_LEVEL;
-}
+static std::atomic<FILE*> _log_stream(stdout);
+
+// One queued line. The sequence says whose turn the slot is: equal to its position when free for
+// the producer claiming that position, one past it once written and ready for the writer.
+struct LogSlot
+    {
+        std::atomic<size_t> sequence;
+        LOGGER level;
+        char text[LOG_LINE_SIZE];
+    };
+
+/*
+    A bounded multi-producer, single-consumer ring after Vyukov's queue. Producers claim a position
+    with one CAS and publish with one store, the writer thread drains in order and writes in batches.
+    A full ring makes producers yield until the writer catches up rather than drop lines.
+*/
+
+class LogRing {
+    public:
+        LogRing()
+            {
+                for (size_t i = 0; i < LOG_RING_SIZE; i++)
+                    { _slots[i].sequence.store(i, std::memory_order_relaxed); }
+
+                _head = 0;
+                _tail = 0;
+                _written = 0;
+                _level = LOG_LEVEL;
+                _running = true;
+                _thread = std::thread(&LogRing::_run, this);
+            }
+
+        ~LogRing()
+            {
+                _running.store(false, std::memory_order_release);
+                _thread.join();
+                _drain();
+            }
+
+        LOGGER level() { return _level.load(std::memory_order_relaxed); }
+        void setLevel(LOGGER level) { _level.store(level, std::memory_order_relaxed); }
+
+        void push(LOGGER level, const char* format, va_list args)
+            {
+                size_t _position = _head.load(std::memory_order_relaxed);
+                LogSlot* _slot;
+
+                while (true)
+                    {
+                        _slot = &_slots[_position & (LOG_RING_SIZE - 1)];
+                        size_t _sequence = _slot->sequence.load(std::memory_order_acquire);
+                        intptr_t _difference = (intptr_t)_sequence - (intptr_t)_position;
+
+                        if (_difference == 0)
+                            {
+                                if (_head.compare_exchange_weak(_position, _position + 1, std::memory_order_relaxed)) { break; }
+                            }
+                        else if (_difference < 0)
+                            {
+                                std::this_thread::yield();
+                                _position = _head.load(std::memory_order_relaxed);
+                            }
+                        else
+                            { _position = _head.load(std::memory_order_relaxed); }
+                    }
+
+                _slot->level = level;
+                vsnprintf(_slot->text, LOG_LINE_SIZE, format, args);
+                _slot->sequence.store(_position + 1, std::memory_order_release);
+            }
+
+        // Waits until everything claimed so far has been written
+        void flush()
+            {
+                size_t _target = _head.load(std::memory_order_acquire);
+
+                while (_written.load(std::memory_order_acquire) < _target)
+                    { std::this_thread::yield(); }
+            }
+
+        // One call per line, stdio's lock keeps lines from different threads whole
+        static void write(LOGGER level, const char* text)
+            {
+                const char* _prefix = "";
+
+                switch (level)
+                    {
+                        case LOGGER::ILINE:
+                        case LOGGER::DLINE:
+                        case LOGGER::VLINE: _prefix = " \t "; break;
+                        case LOGGER::ERROR: _prefix = " [ERROR]: "; break;
+                        case LOGGER::INFO: _prefix = " [INFO]: "; break;
+                        case LOGGER::DEBUG: _prefix = " [DEBUG]: "; break;
+                        case LOGGER::VERBOSE: _prefix = " [VERBOSE]: "; break;
+                        default: break;
+                    }
+
+                fprintf(_log_stream.load(std::memory_order_relaxed), "%s%s\n", _prefix, text);
+            }
+
+    private:
+        LogSlot _slots[LOG_RING_SIZE];
+        alignas(64) std::atomic<size_t> _head;
+        alignas(64) size_t _tail;                   // only the writer touches it
+        std::atomic<size_t> _written;               // lines written, what flush() waits on
+        std::atomic<LOGGER> _level;
+        std::atomic<bool> _running;
+        std::thread _thread;
+
+        void _run()
+            {
+                while (_running.load(std::memory_order_acquire))
+                    {
+                        if (_drain() == 0)
+                            { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }
+                    }
+            }
+
+        // Batches of lines go out with one flush
+        size_t _drain()
+            {
+                size_t _count = 0;
+
+                while (true)
+                    {
+                        LogSlot& _slot = _slots[_tail & (LOG_RING_SIZE - 1)];
+                        if (_slot.sequence.load(std::memory_order_acquire) != _tail + 1) { break; }
+
+                        write(_slot.level, _slot.text);
+
+                        _slot.sequence.store(_tail + LOG_RING_SIZE, std::memory_order_release);
+                        _tail++;
+                        _count++;
+                    }
+
+                if (_count)
+                    {
+                        fflush(_log_stream.load(std::memory_order_relaxed));
+                        _written.store(_tail, std::memory_order_release);
+                    }
+
+                return _count;
+            }
+};
+
+static LogRing& _getRing()
+    {
+        static LogRing _ring;
+        return _ring;
+    }
+
+void _report(LOGGER log_level, const char* format, ...)
+    {
+        LogRing& _ring = _getRing();
+        if (log_level > _ring.level()) { return; }
 
-void report(LOGGER log_level, const char* format, ...){
         std::va_list args;
         va_start(args, format);
 
-        if (letsGo(log_level)) {
-            switch(log_level) {
-                case LOGGER::ILINE:
-                case LOGGER::DLINE:
-                case LOGGER::VLINE:
-                    std::cout << " \t ";
-                    break;
-                case LOGGER::ERROR:
-                    std::cout << " [ERROR]: ";
-                    break;
-                case LOGGER::INFO:
-                    std::cout << " [INFO]: ";
-                    break;
-                case LOGGER::DEBUG:
-                    std::cout << " [DEBUG]: ";
-                    break;
-                case LOGGER::VERBOSE:
-                    std::cout << " [VERBOSE]: ";
-                    break;
-                default:
-                    break;
-            }
-
-            vprintf(format, args);
-            std::cout << std::endl;
-        }
+        // Written straight through behind whatever is queued, the caller may be about to abort
+        if (log_level == LOGGER::ERROR)
+            {
+                char _text[LOG_LINE_SIZE];
+                vsnprintf(_text, LOG_LINE_SIZE, format, args);
+                _ring.flush();
+                LogRing::write(log_level, _text);
+                fflush(_log_stream.load(std::memory_order_relaxed));
+            }
+        else
+            { _ring.push(log_level, format, args); }
+
         va_end(args);
 
-    return;
-}
\ No newline at end of file
+        return;
+    }
+
+// Can only narrow what was compiled in
+void setLogLevel(LOGGER log_level)
+    {
+        _getRing().setLevel(log_level <= LOG_LEVEL ? log_level : LOG_LEVEL);
+        return;
+    }
+
+LOGGER getLogLevel()
+    { return _getRing().level(); }
+
+// Whatever was already written stays where it went, only what's queued from here on follows
+void setLogStream(FILE* stream)
+    {
+        _getRing().flush();
+        fflush(_log_stream.load(std::memory_order_relaxed));
+        _log_stream.store(stream, std::memory_order_relaxed);
+        return;
+    }
+
+void flushLog()
+    {
+        _getRing().flush();
+        fflush(_log_stream.load(std::memory_order_relaxed));
+        return;
+    }
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdio>
 
 enum LOGGER {
     OFF,
@@ -11,6 +12,27 @@ enum LOGGER {
     VERBOSE
 };
 
-static LOGGER LOG_LEVEL = LOGGER::VERBOSE;
+// Anything above this is compiled out, build with -DNOVA_LOG_LEVEL=INFO to strip the chatter
+#ifndef NOVA_LOG_LEVEL
+#define NOVA_LOG_LEVEL VERBOSE
+#endif
 
-void report(LOGGER log_level, const char* message, ...);
\ No newline at end of file
+constexpr LOGGER LOG_LEVEL = LOGGER::NOVA_LOG_LEVEL;
+
+/*
+    report() formats on the calling thread into a slot of a lock-free ring, a writer thread does the
+    writing. Levels above LOG_LEVEL never reach the call, and setLogLevel() filters further at runtime.
+    Errors are written synchronously after everything queued ahead of them, so a report followed by
+    abort() is never lost. Lines go to stdout unless setLogStream() points them elsewhere.
+*/
+
+void _report(LOGGER, const char*, ...) __attribute__((format(printf, 2, 3)));
+void setLogLevel(LOGGER);
+LOGGER getLogLevel();
+void setLogStream(FILE*);
+void flushLog();
+
+#define report(level, ...)                                                  \
+    do {                                                                    \
+        if constexpr ((level) <= LOG_LEVEL) { _report(level, __VA_ARGS__); } \
+    } while (0)
@@ -0,0 +1,186 @@
+#include "startup_profiler.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
+static thread_local uint32_t _open_stages = 0;
+
+// Time this thread has spent on a CPU, in milliseconds
+static inline double _getThreadCPUTime()
+    {
+        timespec _time;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &_time);
+
+        return _time.tv_sec * 1e3 + _time.tv_nsec / 1e6;
+    }
+
+// The first call starts the clock, so it should happen as early in launch as possible
+StartupProfiler& StartupProfiler::get()
+    {
+        static StartupProfiler _profiler;
+        return _profiler;
+    }
+
+StartupProfiler::StartupProfiler()
+    {
+        _origin = std::chrono::steady_clock::now();
+        _finished = false;
+    }
+
+double StartupProfiler::now()
+    { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _origin).count(); }
+
+void StartupProfiler::record(const char* name, uint32_t depth, double start_ms, double end_ms, double cpu_ms)
+    {
+        std::lock_guard<std::mutex> _lock(_mutex);
+        if (finished()) { return; }
+
+        _stages.push_back({
+                .name = name,
+                .thread = std::this_thread::get_id(),
+                .depth = depth,
+                .start_ms = start_ms,
+                .end_ms = end_ms,
+                .cpu_ms = cpu_ms
+            });
+    }
+
+// Reports once, a JSON file when given a path and the log otherwise
+void StartupProfiler::finish(const char* path)
+    {
+        std::lock_guard<std::mutex> _lock(_mutex);
+        if (_finished.exchange(true)) { return; }
+
+        double _first_frame_ms = now();
+
+        std::sort(_stages.begin(), _stages.end(), [](const Stage& a, const Stage& b) { return a.start_ms < b.start_ms; });
+
+        if (path != nullptr) { _writeJSON(_first_frame_ms, path); }
+        else { _writeText(_first_frame_ms); }
+
+        return;
+    }
+
+// Threads are numbered in the order they first opened a stage. Busy time counts each thread's
+// outermost stages, overlap is how much of that ran while another thread was busy too.
+void StartupProfiler::_summarize(std::vector<uint32_t>& threads, uint32_t& thread_ct, double& busy_ms, double& overlap_ms)
+    {
+        std::vector<std::thread::id> _ids;
+        std::vector<std::pair<double, double>> _spans;
+
+        threads.resize(_stages.size());
+        busy_ms = 0.0;
+
+        for (size_t i = 0; i < _stages.size(); i++)
+            {
+                auto _found = std::find(_ids.begin(), _ids.end(), _stages[i].thread);
+                threads[i] = static_cast<uint32_t>(_found - _ids.begin());
+                if (_found == _ids.end()) { _ids.push_back(_stages[i].thread); }
+
+                if (_stages[i].depth != 0) { continue; }
+
+                busy_ms += _stages[i].end_ms - _stages[i].start_ms;
+                _spans.push_back({ _stages[i].start_ms, _stages[i].end_ms });
+            }
+
+        // Stages are sorted by start, so the spans can be merged in one pass
+        double _covered_ms = 0.0, _span_start = 0.0, _span_end = -1.0;
+
+        for (const auto& _span : _spans)
+            {
+                if (_span.first > _span_end)
+                    {
+                        if (_span_end > _span_start) { _covered_ms += _span_end - _span_start; }
+                        _span_start = _span.first;
+                    }
+
+                _span_end = std::max(_span_end, _span.second);
+            }
+
+        if (_span_end > _span_start) { _covered_ms += _span_end - _span_start; }
+
+        thread_ct = static_cast<uint32_t>(_ids.size());
+        overlap_ms = busy_ms - _covered_ms;
+
+        return;
+    }
+
+void StartupProfiler::_writeText(double first_frame_ms)
+    {
+        std::vector<uint32_t> _threads;
+        uint32_t _thread_ct;
+        double _busy_ms, _overlap_ms;
+        _summarize(_threads, _thread_ct, _busy_ms, _overlap_ms);
+
+        report(LOGGER::INFO, "Startup - First Frame at %.2f ms, %.2f ms of Stages on %u Threads, %.2f ms Overlapped ..",
+                first_frame_ms, _busy_ms, _thread_ct, _overlap_ms);
+
+        for (size_t i = 0; i < _stages.size(); i++)
+            {
+                const Stage& _stage = _stages[i];
+                report(LOGGER::ILINE, "\t[%u] %*s%-*s %9.2f ms  wall %8.2f  cpu %8.2f",
+                        _threads[i], _stage.depth * 2, "", 32 - _stage.depth * 2, _stage.name,
+                        _stage.start_ms, _stage.end_ms - _stage.start_ms, _stage.cpu_ms);
+            }
+
+        return;
+    }
+
+void StartupProfiler::_writeJSON(double first_frame_ms, const char* path)
+    {
+        FILE* _file = fopen(path, "w");
+        if (_file == nullptr)
+            {
+                report(LOGGER::ERROR, "Startup - Could not open %s, Reporting to the Log ..", path);
+                _writeText(first_frame_ms);
+                return;
+            }
+
+        std::vector<uint32_t> _threads;
+        uint32_t _thread_ct;
+        double _busy_ms, _overlap_ms;
+        _summarize(_threads, _thread_ct, _busy_ms, _overlap_ms);
+
+        fprintf(_file, "{\n  \"first_frame_ms\": %.3f,\n  \"threads\": %u,\n  \"busy_ms\": %.3f,\n  \"overlap_ms\": %.3f,\n  \"stages\": [",
+                first_frame_ms, _thread_ct, _busy_ms, _overlap_ms);
+
+        for (size_t i = 0; i < _stages.size(); i++)
+            {
+                const Stage& _stage = _stages[i];
+                fprintf(_file, "%s\n    { \"name\": \"%s\", \"thread\": %u, \"depth\": %u, \"start_ms\": %.3f, \"wall_ms\": %.3f, \"cpu_ms\": %.3f }",
+                        i ? "," : "", _stage.name, _threads[i], _stage.depth, _stage.start_ms, _stage.end_ms - _stage.start_ms, _stage.cpu_ms);
+            }
+
+        fprintf(_file, "\n  ]\n}\n");
+        fclose(_file);
+
+        report(LOGGER::INFO, "Startup - First Frame at %.2f ms, Report Written to %s ..", first_frame_ms, path);
+
+        return;
+    }
+
+
+    ///////////////////
+    // STARTUP TIMER //
+    ///////////////////
+
+StartupTimer::StartupTimer(const char* name)
+    {
+        _name = name;
+        _active = !StartupProfiler::get().finished();
+        if (!_active) { return; }
+
+        _start_ms = StartupProfiler::get().now();
+        _cpu_start_ms = _getThreadCPUTime();
+        _open_stages++;
+    }
+
+StartupTimer::~StartupTimer()
+    {
+        if (!_active) { return; }
+
+        _open_stages--;
+        StartupProfiler::get().record(_name, _open_stages, _start_ms, StartupProfiler::get().now(), _getThreadCPUTime() - _cpu_start_ms);
+    }
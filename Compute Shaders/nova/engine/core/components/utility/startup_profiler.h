@@ -0,0 +1,61 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    The StartupProfiler collects scoped timings of everything between launch and the first frame.
+    STARTUP_STAGE() at the top of an init function records its wall and CPU time on whichever
+    thread runs it, nested under any stage already open on that thread. finish() is called once the
+    first frame is out and reports where the time went, and how much of it threads spent overlapped.
+    Stages opened after that cost a single atomic load.
+*/
+
+class StartupProfiler {
+    public:
+        static StartupProfiler& get();
+
+        double now();
+        bool finished() { return _finished.load(std::memory_order_relaxed); }
+        void record(const char*, uint32_t, double, double, double);
+        void finish(const char* = nullptr);
+
+    private:
+        struct Stage
+            {
+                const char* name;
+                std::thread::id thread;
+                uint32_t depth;                 // stages open on the same thread around this one
+                double start_ms;
+                double end_ms;
+                double cpu_ms;
+            };
+
+        std::chrono::steady_clock::time_point _origin;
+        std::vector<Stage> _stages;
+        std::mutex _mutex;
+        std::atomic<bool> _finished;
+
+        StartupProfiler();
+
+        void _summarize(std::vector<uint32_t>&, uint32_t&, double&, double&);
+        void _writeText(double);
+        void _writeJSON(double, const char*);
+};
+
+class StartupTimer {
+    public:
+        StartupTimer(const char*);
+        ~StartupTimer();
+
+    private:
+        const char* _name;
+        bool _active;
+        double _start_ms;
+        double _cpu_start_ms;
+};
+
+#define STARTUP_STAGE() StartupTimer _startup_stage(__func__)
@@ -0,0 +1,149 @@
+#include "task_graph.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+
+TaskGraph::TaskGraph()
+    {
+        _remaining = 0;
+        _threads = 0;
+        _wall_ms = 0.0;
+    }
+
+TaskGraph::~TaskGraph()
+    {}
+
+// Returns the id later tasks name as a dependency
+uint32_t TaskGraph::add(const char* name, std::function<void()> fn, std::initializer_list<uint32_t> dependencies)
+    {
+        uint32_t _id = static_cast<uint32_t>(_tasks.size());
+
+        for (uint32_t _dependency : dependencies)
+            {
+                if (_dependency >= _id)
+                    {
+                        report(LOGGER::ERROR, "TaskGraph - %s Depends on a Task Not Yet Added ..", name);
+                        abort();
+                    }
+
+                _tasks[_dependency].dependents.push_back(_id);
+            }
+
+        _tasks.push_back({
+                .name = name,
+                .fn = fn,
+                .dependencies = dependencies,
+                .dependents = {},
+                .waiting = 0,
+                .start_ms = 0.0,
+                .end_ms = 0.0
+            });
+
+        return _id;
+    }
+
+// Blocks until every task has run. 0 threads means one per hardware thread, never more than there are tasks.
+void TaskGraph::run(uint32_t threads)
+    {
+        report(LOGGER::VLINE, "\t .. Running Task Graph ..");
+
+        if (_tasks.empty()) { return; }
+
+        for (uint32_t i = 0; i < _tasks.size(); i++)
+            {
+                _tasks[i].waiting = _tasks[i].dependencies.size();
+                if (_tasks[i].waiting == 0) { _ready.push_back(i); }
+            }
+
+        _remaining = _tasks.size();
+        _threads = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+        _threads = std::min(_threads, static_cast<uint32_t>(_tasks.size()));
+        _start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> _pool;
+        for (uint32_t i = 0; i < _threads; i++)
+            { _pool.emplace_back(&TaskGraph::_work, this); }
+
+        for (auto& _thread : _pool)
+            { _thread.join(); }
+
+        _wall_ms = _elapsed();
+
+        return;
+    }
+
+void TaskGraph::_work()
+    {
+        std::unique_lock<std::mutex> _lock(_mutex);
+
+        while (true)
+            {
+                _wake.wait(_lock, [this] { return _remaining == 0 || !_ready.empty(); });
+
+                if (_ready.empty()) { return; }
+
+                Task& _task = _tasks[_ready.front()];
+                _ready.pop_front();
+
+                _lock.unlock();
+                _task.start_ms = _elapsed();
+                _task.fn();
+                _task.end_ms = _elapsed();
+                _lock.lock();
+
+                _remaining--;
+
+                for (uint32_t _dependent : _task.dependents)
+                    { if (--_tasks[_dependent].waiting == 0) { _ready.push_back(_dependent); } }
+
+                _wake.notify_all();
+            }
+    }
+
+double TaskGraph::_elapsed()
+    { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _start).count(); }
+
+// The critical path is the longest chain by task time alone, what the graph would take with unlimited threads.
+// Wall time above it is waiting on a thread, below it can't happen.
+void TaskGraph::log()
+    {
+        if (_tasks.empty()) { return; }
+
+        std::vector<double> _path_ms(_tasks.size());
+        std::vector<int64_t> _previous(_tasks.size(), -1);
+        uint32_t _last = 0;
+
+        for (uint32_t i = 0; i < _tasks.size(); i++)
+            {
+                double _longest = 0.0;
+
+                for (uint32_t _dependency : _tasks[i].dependencies)
+                    {
+                        if (_path_ms[_dependency] > _longest)
+                            {
+                                _longest = _path_ms[_dependency];
+                                _previous[i] = _dependency;
+                            }
+                    }
+
+                _path_ms[i] = _longest + _tasks[i].end_ms - _tasks[i].start_ms;
+                if (_path_ms[i] > _path_ms[_last]) { _last = i; }
+            }
+
+        report(LOGGER::INFO, "TaskGraph - %zu Tasks on %u Threads in %.2f ms, Critical Path %.2f ms ..",
+                _tasks.size(), _threads, _wall_ms, _path_ms[_last]);
+
+        for (const auto& _task : _tasks)
+            { report(LOGGER::DLINE, "\t%-24s %8.2f - %8.2f ms", _task.name, _task.start_ms, _task.end_ms); }
+
+        std::vector<uint32_t> _path;
+        for (int64_t i = _last; i != -1; i = _previous[i])
+            { _path.push_back(static_cast<uint32_t>(i)); }
+
+        for (auto it = _path.rbegin(); it != _path.rend(); it++)
+            { report(LOGGER::ILINE, "\t%-24s %8.2f ms", _tasks[*it].name, _tasks[*it].end_ms - _tasks[*it].start_ms); }
+
+        return;
+    }
@@ -0,0 +1,51 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <vector>
+
+/*
+    The TaskGraph runs named tasks on a small pool of threads, each one as soon as everything it
+    depends on has finished. A task can only depend on tasks added before it, so the graph can't
+    hold a cycle and the order they were added in is already a valid order to run them in.
+    Every task is timed, and log() reports the critical path, the chain of dependencies that
+    bounds how fast the graph can run however many threads it's given.
+*/
+
+class TaskGraph {
+    public:
+        TaskGraph();
+        ~TaskGraph();
+
+        uint32_t add(const char*, std::function<void()>, std::initializer_list<uint32_t> = {});
+        void run(uint32_t = 0);
+        void log();
+
+    private:
+        struct Task
+            {
+                const char* name;
+                std::function<void()> fn;
+                std::vector<uint32_t> dependencies;
+                std::vector<uint32_t> dependents;
+                size_t waiting;                 // dependencies still running, guarded by _mutex
+                double start_ms;
+                double end_ms;
+            };
+
+        std::vector<Task> _tasks;
+        std::deque<uint32_t> _ready;
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        size_t _remaining;
+        uint32_t _threads;
+        double _wall_ms;
+        std::chrono::steady_clock::time_point _start;
+
+        void _work();
+        double _elapsed();
+};
@@ -0,0 +1,186 @@
+#include "trace_recorder.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
+static thread_local uint32_t _thread_track = 0;
+
+TraceRecorder& TraceRecorder::get()
+    {
+        static TraceRecorder _recorder;
+        return _recorder;
+    }
+
+TraceRecorder::TraceRecorder()
+    {
+        _path = nullptr;
+        _first_frame = 0;
+        _frame_ct = 0;
+        _start_ns = 0;
+        _stop_ns = UINT64_MAX;
+        _threads = 0;
+        _recording = false;
+        _open = false;
+    }
+
+// The clock VK_EXT_calibrated_timestamps calibrates against as VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT
+uint64_t TraceRecorder::now()
+    {
+        timespec _time;
+        clock_gettime(CLOCK_MONOTONIC, &_time);
+
+        return (uint64_t)_time.tv_sec * 1000000000ULL + _time.tv_nsec;
+    }
+
+// Nothing is recorded until this names a file, frames [first, first + count) are kept
+void TraceRecorder::configure(const char* path, uint64_t first_frame, uint64_t frame_count)
+    {
+        std::lock_guard<std::mutex> _lock(_mutex);
+
+        _path = path;
+        _first_frame = first_frame;
+        _frame_ct = frame_count ? frame_count : 1;
+
+        report(LOGGER::INFO, "TraceRecorder - Tracing Frames %llu to %llu into %s ..",
+                (unsigned long long)_first_frame, (unsigned long long)(_first_frame + _frame_ct - 1), _path);
+
+        return;
+    }
+
+// Threads are numbered from 1 in the order they first record
+uint32_t TraceRecorder::thread()
+    {
+        if (_thread_track == 0) { _thread_track = _threads.fetch_add(1, std::memory_order_relaxed) + 1; }
+        return _thread_track;
+    }
+
+void TraceRecorder::nameThread(const char* name)
+    {
+        nameTrack(thread(), name);
+        return;
+    }
+
+void TraceRecorder::nameTrack(uint32_t track, const char* name)
+    {
+        std::lock_guard<std::mutex> _lock(_mutex);
+
+        for (auto& _track : _tracks)
+            { if (_track.first == track) { _track.second = name; return; } }
+
+        _tracks.push_back({ track, name });
+
+        return;
+    }
+
+void TraceRecorder::record(const char* name, uint32_t track, uint64_t start_ns, uint64_t end_ns)
+    {
+        std::lock_guard<std::mutex> _lock(_mutex);
+        if (!open() || start_ns < _start_ns || start_ns >= _stop_ns) { return; }
+
+        _events.push_back({ .name = name, .track = track, .start_ns = start_ns, .end_ns = end_ns });
+
+        return;
+    }
+
+// Called from the render thread with the frame about to be drawn. A frame that's
+// started over, after an out of date swapchain, calls it again with the same number.
+void TraceRecorder::frame(uint64_t frame_number)
+    {
+        if (_path == nullptr) { return; }
+
+        uint64_t _last_frame = _first_frame + _frame_ct;
+
+        if (frame_number == _first_frame && !open())
+            {
+                std::lock_guard<std::mutex> _lock(_mutex);
+                _events.clear();
+                _events.reserve(4096);
+                _start_ns = now();
+                _stop_ns = UINT64_MAX;
+                _open = true;
+                _recording = true;
+            }
+        else if (frame_number == _last_frame && recording())
+            {
+                std::lock_guard<std::mutex> _lock(_mutex);
+                _recording = false;
+                _stop_ns = now();
+            }
+        else if (frame_number >= _last_frame + TRACE_DRAIN_FRAMES && open())
+            { finish(); }
+
+        return;
+    }
+
+// Writes whatever the window holds, early if the engine shuts down inside it
+void TraceRecorder::finish()
+    {
+        std::lock_guard<std::mutex> _lock(_mutex);
+        if (!_open.exchange(false)) { return; }
+
+        _recording = false;
+        _write();
+        _path = nullptr;
+
+        return;
+    }
+
+// Chrome's JSON trace event format: complete events in microseconds, with metadata naming each track
+void TraceRecorder::_write()
+    {
+        FILE* _file = fopen(_path, "w");
+        if (_file == nullptr)
+            {
+                report(LOGGER::ERROR, "TraceRecorder - Could not open %s ..", _path);
+                return;
+            }
+
+        std::sort(_events.begin(), _events.end(), [](const Event& a, const Event& b) { return a.start_ns < b.start_ns; });
+
+        fprintf(_file, "{\n  \"displayTimeUnit\": \"ms\",\n  \"traceEvents\": [");
+
+        bool _first = true;
+        for (const auto& _track : _tracks)
+            {
+                fprintf(_file, "%s\n    { \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %u, \"args\": { \"name\": \"%s\" } }",
+                        _first ? "" : ",", _track.first, _track.second.c_str());
+                _first = false;
+            }
+
+        for (const Event& _event : _events)
+            {
+                fprintf(_file, "%s\n    { \"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, \"ts\": %.3f, \"dur\": %.3f }",
+                        _first ? "" : ",", _event.name, _event.track,
+                        (_event.start_ns - _start_ns) / 1e3, (_event.end_ns - _event.start_ns) / 1e3);
+                _first = false;
+            }
+
+        fprintf(_file, "\n  ]\n}\n");
+        fclose(_file);
+
+        report(LOGGER::INFO, "TraceRecorder - %zu Events Written to %s ..", _events.size(), _path);
+        _events.clear();
+
+        return;
+    }
+
+
+    /////////////////
+    // TRACE SCOPE //
+    /////////////////
+
+TraceScope::TraceScope(const char* name)
+    {
+        _name = name;
+        _start_ns = TraceRecorder::get().recording() ? TraceRecorder::now() : 0;
+    }
+
+TraceScope::~TraceScope()
+    {
+        if (_start_ns == 0) { return; }
+
+        TraceRecorder& _recorder = TraceRecorder::get();
+        _recorder.record(_name, _recorder.thread(), _start_ns, TraceRecorder::now());
+    }
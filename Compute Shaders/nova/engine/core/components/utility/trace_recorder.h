@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+const uint32_t TRACE_GPU_TRACK = 1000;          // GPU tracks are this plus the queue family
+const uint64_t TRACE_DRAIN_FRAMES = 2;          // frames the file waits after the window for late GPU scopes
+
+/*
+    The TraceRecorder keeps a window of frames as a Chrome trace, which chrome://tracing and Perfetto
+    both open. TRACE_SCOPE() records a span on the calling thread's track, GPU scopes arrive already
+    mapped onto the same CLOCK_MONOTONIC timeline on a track per queue family. frame() is called at the
+    top of every frame and opens the window, stops it and writes it out once the GPU has caught up.
+    Outside the window a scope costs one atomic load.
+*/
+
+class TraceRecorder {
+    public:
+        static TraceRecorder& get();
+        static uint64_t now();
+        static uint32_t gpuTrack(uint32_t family) { return TRACE_GPU_TRACK + family; }
+
+        void configure(const char*, uint64_t, uint64_t);
+        bool recording() { return _recording.load(std::memory_order_relaxed); }
+        bool open() { return _open.load(std::memory_order_relaxed); }
+        uint32_t thread();
+        void nameThread(const char*);
+        void nameTrack(uint32_t, const char*);
+        void record(const char*, uint32_t, uint64_t, uint64_t);
+        void frame(uint64_t);
+        void finish();
+
+    private:
+        struct Event
+            {
+                const char* name;
+                uint32_t track;
+                uint64_t start_ns;
+                uint64_t end_ns;
+            };
+
+        const char* _path;
+        uint64_t _first_frame;
+        uint64_t _frame_ct;
+        uint64_t _start_ns;                     // CPU scopes must begin, and GPU scopes start, inside these
+        uint64_t _stop_ns;
+        std::vector<Event> _events;
+        std::vector<std::pair<uint32_t, std::string>> _tracks;
+        std::mutex _mutex;
+        std::atomic<uint32_t> _threads;
+        std::atomic<bool> _recording;           // CPU scopes are being taken
+        std::atomic<bool> _open;                // events are accepted, until the file is written
+
+        TraceRecorder();
+
+        void _write();
+};
+
+class TraceScope {
+    public:
+        TraceScope(const char*);
+        ~TraceScope();
+
+    private:
+        const char* _name;
+        uint64_t _start_ns;
+};
+
+#define TRACE_SCOPE(name) TraceScope _trace_scope(name)
@@ -1,6 +1,11 @@
 #pragma once
 #include "./sectors/00atomic/pipeline/pipeline.h"
+#include "./sectors/00atomic/descriptor/descriptor_allocator.h"
+#include "./sectors/00atomic/descriptor/bindless.h"
+#include "./sectors/00atomic/descriptor/descriptor_binder.h"
 #include "./sectors/00atomic/lexicon.h"
+#include "./sectors/05telemetry/gpu_profiler.h"
+#include "./sectors/05telemetry/pipeline_statistics.h"
 
 
 class NovaCore {
@@ -10,10 +15,14 @@ class NovaCore {
         Queues queues;
         SwapChainContext swapchain;
         VkSurfaceKHR surface;
+        EngineConfig config;
+        GpuProfiler gpu_profiler;               // named GPU scopes in both command buffers
+        PipelineStatistics pipeline_statistics; // invocation counts for the dispatch and the draw
+        FrameStats frame_stats;                 // frame time percentiles, summarized periodically and on exit
 
         bool framebuffer_resized = false;
 
-        NovaCore(VkExtent2D);
+        NovaCore(VkExtent2D, EngineConfig);
         ~NovaCore();
 
         void log();
@@ -24,6 +33,7 @@ class NovaCore {
         void createPhysicalDevice();
         void createLogicalDevice(); 
         void constructSwapChain();
+        void constructOffscreenTargets();
         void constructImageViews();
         void createFrameBuffers();
         void createRenderPass();
@@ -37,28 +47,52 @@ class NovaCore {
         void constructVertexBuffer();
         void constructIndexBuffer();
         void constructUniformBuffer();
+        void generateParticles();
         void constructStorageBuffers();
         void constructDescriptorPool();
         void createDescriptorSets();
         void createComputeDescriptorSets();
         void createComputeDescriptorSetLayout();
+        void createBindlessTable();
         void createCommandBuffers();
         void createSyncObjects();
+        void createCaptureRing();
+        void createRenderTargets();
+        void createGpuProfiler();
+        void createPipelineStatistics();
+        void startBenchmark();
+        void writeBenchmark();
         void constructGraphicsPipeline();
         void constructComputePipeline();
+        void createHud();
+        void constructHudPipeline();
+        void rebuildForSurfaceFormat();
+        void toggleHud();
+        void control(const char*, std::string&);
         
         void drawFrame();
+        void setRenderState(RenderState);
+        VkPresentModeKHR setPresentPolicy(PRESENT_POLICY);
 
     private:
         VkPhysicalDevice physical_device;
+        VkPhysicalDeviceProperties device_properties;
         VkPhysicalDeviceSubgroupProperties subgroup_properties;
+        DeviceFeatures device_features;         // what the selected device supports
+        DynamicStateCommands dynamic_state;
+        RenderState render_state;               // recorded every frame when the pipeline leaves it dynamic
         FrameData frames[MAX_FRAMES_IN_FLIGHT];
         ComputeData computes[MAX_FRAMES_IN_FLIGHT]; // TODO: Get Max Compute Queues from Device when we query the queue count
         VkRenderPass render_pass;
         QueuePresentContext present;
+        DescriptorAllocator descriptor_allocator;   // sets that live as long as the context
         DescriptorContext descriptor;           // TODO: Create a createNewDescriptor function (and combine with uniform?)
-        GraphicsPipeline *graphics_pipeline;    // TODO: Dynamically allocate pipelines with a createNewPipeline function that takes a type and/or shader file
+        PipelineRegistry pipelines;             // Builders hash their state here and share any pipeline that already exists
+        GraphicsPipeline *graphics_pipeline;
         DescriptorContext compute_descriptor;   // TODO: Incorporate this as part of the Pipeline class
+        BindlessTable bindless;                 // every registered resource, bound once per command buffer
+        DescriptorBinder binder;                // writes the compute bindings at record time for push descriptors and descriptor buffers
+        BufferContext descriptor_buffer;        // backs the binder under BINDING_DESCRIPTOR_BUFFER
         ComputePipeline *compute_pipeline;
         BufferContext vertex;                   // TODO: Combine vertex and index into a single Object Buffer
         BufferContext index;                    //       and create a createNewObject function
@@ -68,8 +102,28 @@ class NovaCore {
         std::vector<BufferContext> uniform;
         std::vector<void*> uniform_data;
         std::vector<BufferContext> storage;
-        const uint32_t MAX_PARTICLES = 499294;
-
+        std::vector<uint32_t> storage_slots;    // bindless indices of the storage buffers
+        std::vector<Particle> particles;        // initial state, held only until it's uploaded
+        uint32_t particle_capacity = 0;         // particles the storage buffers hold, config.particle_count can drop below it
+
+        CaptureSlot captures[CAPTURE_RING_SIZE];
+        uint32_t capture_cursor = 0;
+        FrameWriter capture_writer;             // encodes and writes the captures off the render thread
+
+        GraphicsPipeline *hud_pipeline;         // the overlay, null unless config.hud
+        BufferContext hud_quads[MAX_FRAMES_IN_FLIGHT];  // per frame instance buffers the HudCanvas writes into
+        HudQuad* hud_mapped[MAX_FRAMES_IN_FLIGHT] = {};
+        HudSeries hud_cpu;                      // frame times in ms for the graphs
+        HudSeries hud_gpu;
+        char hud_lines[HUD_LINES][HUD_LINE_LENGTH] = {};   // text is only reformatted a few times a second
+        double hud_refreshed = 0.0;
+        bool hud_visible = true;
+
+        std::vector<ImageContext> render_targets;   // drawn at the render scale, then blitted to the swapchain
+        float render_scale = 1.0f;              // fraction of the swapchain extent being rendered
+        double gpu_frame_ms = 0.0;              // moving average of the graphics command buffer's GPU time
+
+        SimulationParams simulation;            // pushed with every dispatch
         double last_time = 0.0;
         float last_frame_time = 0.0f;
 
@@ -78,10 +132,15 @@ class NovaCore {
         FrameData& current_frame();
         ComputeData& current_compute();
         int _frame_ct = 0;
+        uint64_t frame_number = 0;              // frames submitted since start up, retires old swapchains
         VkSampleCountFlagBits msaa_samples = VK_SAMPLE_COUNT_1_BIT;
         uint32_t mip_lvls = 1;
 
         void syncClock();
+        double deviceMemoryMB();
+        void controlStats(std::string&);
+        void controlGet(const char*, std::string&);
+        void controlSet(const char*, const char*, std::string&);
 
         void logQueues();
         void logSwapChain();
@@ -94,6 +153,7 @@ class NovaCore {
 
         SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice);
         bool deviceProvisioned(VkPhysicalDevice);
+        void queryDeviceFeatures();
         bool checkValidationLayerSupport();
         void getQueueFamilies(VkPhysicalDevice);
         VkDeviceQueueCreateInfo getQueueCreateInfo(uint32_t);
@@ -101,14 +161,20 @@ class NovaCore {
 
         VkMemoryAllocateInfo getMemoryAllocateInfo(VkMemoryRequirements, VkMemoryPropertyFlags);
 
-        void createSwapchainInfoKHR(VkSwapchainCreateInfoKHR*, uint32_t);
+        void createSwapchainInfoKHR(VkSwapchainCreateInfoKHR*, uint32_t, VkSwapchainKHR);
         VkImageViewCreateInfo createImageViewInfo(VkImage, VkFormat, VkImageAspectFlags, uint32_t);
         void recreateSwapChain();
+        void retireSwapChain(VkSwapchainKHR);
+        void destroyRetiredSwapChains(bool);
 
         VkFormat findDepthFormat(VkImageTiling);
         VkAttachmentDescription getDepthAttachment();
         VkRenderPassBeginInfo getRenderPassInfo(size_t);
         VkAttachmentDescription getColorAttachment();
+        void beginRendering(VkCommandBuffer&, uint32_t);
+        void endRendering(VkCommandBuffer&, uint32_t);
+        VkImageLayout getTargetLayout();
+        void recordImageBarrier(VkCommandBuffer&, VkImage, VkImageLayout, VkImageLayout, VkPipelineStageFlags, VkAccessFlags, VkPipelineStageFlags, VkAccessFlags);
 
         VkCommandBufferBeginInfo createBeginInfo();
         VkCommandBufferAllocateInfo createCommandBuffersInfo(VkCommandPool&, char*, uint32_t);
@@ -119,8 +185,21 @@ class NovaCore {
         void copyBuffer(VkBuffer, VkBuffer, VkDeviceSize, VkQueue&, VkCommandPool&);
         void recordCommandBuffers(VkCommandBuffer&, uint32_t); 
         void recordComputeCommandBuffer(VkCommandBuffer&, uint32_t);
+        void drawOffscreen();
+        void _endFrame();
+        void recordCapture(VkCommandBuffer&, uint32_t);
+        void recordHud(VkCommandBuffer&);
+        void refreshHud();
+        void collectCaptures(bool);
+        void destroyCaptureRing();
+        VkExtent2D renderExtent();
+        void recordUpscale(VkCommandBuffer&, uint32_t);
+        void updateRenderScale();
+        void destroyRenderTargets(std::vector<ImageContext>&);
+        void loadDynamicStateCommands();
+        void recordRenderState(VkCommandBuffer&);
         void resetCommandBuffers();
-        void updateUniformBuffer(uint32_t);
+        void updateSimulation();
 
         VkImageMemoryBarrier getMemoryBarrier(VkImage&, VkImageLayout&, VkImageLayout&, uint32_t mip_level = 1);
         void createImage(uint32_t, uint32_t, uint32_t, VkSampleCountFlagBits, VkFormat, VkImageTiling, VkImageUsageFlags, VkMemoryPropertyFlags, VkImage&, VkDeviceMemory&);
@@ -137,6 +216,7 @@ class NovaCore {
         void destroyPipeline(GraphicsPipeline*);
         void destroyPipeline(ComputePipeline*);
         void destroyComputeResources();
+        void destroyHud();
 };
 
 
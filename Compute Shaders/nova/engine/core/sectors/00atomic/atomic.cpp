@@ -36,7 +36,10 @@ void destroyDebugUtilsMessengerEXT(VkInstance instance, VkDebugUtilsMessengerEXT
         auto destroyDebugUtilsExt = (PFN_vkDestroyDebugUtilsMessengerEXT)vkGetInstanceProcAddr(instance, "vkDestroyDebugUtilsMessengerEXT");
 
         if (destroyDebugUtilsExt != nullptr) 
-            { destroyDebugUtilsExt(instance, debugMessenger, pAllocator); } 
+            { 
+                RELEASE_OBJECT(VK_OBJECT_TYPE_DEBUG_UTILS_MESSENGER_EXT, debugMessenger);
+                destroyDebugUtilsExt(instance, debugMessenger, pAllocator); 
+            } 
         else 
             { report(LOGGER::ERROR, "Vulkan: vkDestroyDebugUtilsMessengerEXT not available"); }
     }
@@ -64,7 +67,10 @@ void createDebugMessenger(VkInstance *instance, VkDebugUtilsMessengerEXT *_debug
         auto createDebugUtilsExt = (PFN_vkCreateDebugUtilsMessengerEXT)vkGetInstanceProcAddr(*instance, "vkCreateDebugUtilsMessengerEXT");
 
         if (createDebugUtilsExt != nullptr) 
-            { createDebugUtilsExt(*instance, &create_info, nullptr, _debug_messenger); } 
+            { 
+                createDebugUtilsExt(*instance, &create_info, HOST_ALLOCATOR, _debug_messenger); 
+                REGISTER_OBJECT(VK_OBJECT_TYPE_DEBUG_UTILS_MESSENGER_EXT, *_debug_messenger, 0);
+            } 
         else 
             { report(LOGGER::ERROR, "Vulkan: vkCreateDebugUtilsMessengerEXT not available\n"); }
     }
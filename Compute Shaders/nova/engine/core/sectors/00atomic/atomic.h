@@ -1,8 +1,15 @@
 #pragma once
 #include "lexicon.h"
+#include "../../components/utility/frame_writer.h"
+#include "../../components/utility/startup_profiler.h"
+#include "../../components/utility/trace_recorder.h"
+#include "../../components/utility/frame_stats.h"
+#include "../../components/utility/hud_canvas.h"
+#include "../../components/utility/control_socket.h"
 
 #include <optional>
 #include <vector>
+#include <cstring>
 #include <deque>
 #include <functional>
 #include <glm/glm.hpp>
@@ -17,6 +24,8 @@ typedef void (*fnManifest)();
 const bool USE_VALIDATION_LAYERS = true;
 constexpr unsigned int MAX_FRAMES_IN_FLIGHT = 2;
 constexpr unsigned int MAX_COMPUTE_QUEUES = 4;
+constexpr uint32_t CAPTURE_RING_SIZE = MAX_FRAMES_IN_FLIGHT + 2;    // readbacks in flight plus a couple being encoded
+constexpr uint32_t MAX_PUSH_CONSTANT_SIZE = 128;       // the minimum maxPushConstantsSize every device guarantees
 const std::vector<const char*> VALIDATION_LAYERS = { "VK_LAYER_KHRONOS_validation" };
 const uint32_t VALIDATION_LAYER_COUNT = static_cast<uint32_t>(VALIDATION_LAYERS.size());
 const std::vector<const char*> DEVICE_EXTENSIONS = { VK_KHR_SWAPCHAIN_EXTENSION_NAME, };
@@ -26,6 +35,149 @@ const std::vector<const char*> DEVICE_EXTENSIONS = { VK_KHR_SWAPCHAIN_EXTENSION_
     // STRUCT DEFINITIONS //
     ////////////////////////
 
+// How the compute pass gets its particle buffers. Anything the device lacks falls back to descriptor sets.
+enum BINDING_BACKEND {
+    BINDING_DESCRIPTOR_SETS,            // a set per frame in flight, allocated and written once
+    BINDING_BINDLESS,                   // one descriptor indexing table, buffer slots go through push constants
+    BINDING_PUSH_DESCRIPTORS,           // VK_KHR_push_descriptor, writes are recorded straight into the command buffer
+    BINDING_DESCRIPTOR_BUFFER           // VK_EXT_descriptor_buffer, descriptors are written into a GPU visible buffer
+};
+
+// What the swapchain optimizes for. Each policy walks its own preference list of present modes,
+// FIFO is the last resort for all of them since every device has it.
+enum PRESENT_POLICY {
+    PRESENT_LATENCY,                    // MAILBOX, IMMEDIATE, FIFO_RELAXED: newest frame on screen, no queueing behind vsync
+    PRESENT_THROUGHPUT,                 // MAILBOX, FIFO_RELAXED, with an extra image so the GPU rarely waits to acquire
+    PRESENT_POWER_SAVE,                 // FIFO only: capped at the refresh rate
+    PRESENT_UNCAPPED                    // IMMEDIATE, MAILBOX, FIFO_RELAXED: raw GPU throughput for benchmarks, tearing allowed
+};
+
+// NOVA_PRESENT_POLICY, the control socket and the benchmark files use the keys, the log the names
+const char* const PRESENT_POLICY_KEYS[] = { "latency", "throughput", "power_save", "uncapped" };
+const char* const PRESENT_POLICY_NAMES[] = { "Latency", "Throughput", "Power Save", "Uncapped" };
+
+// Options chosen at initialization. NovaCore clears any the device can't honour, so after
+// createPhysicalDevice() this reflects what the engine is actually running with.
+struct EngineConfig
+    {
+        bool dynamic_rendering = true;      // VK_KHR_dynamic_rendering in place of VkRenderPass and VkFramebuffer
+        uint32_t dynamic_state_level = 3;   // highest VK_EXT_extended_dynamic_state revision to use, 0 for none
+        BINDING_BACKEND binding_backend = BINDING_BINDLESS;
+        PRESENT_POLICY present_policy = PRESENT_POWER_SAVE;
+        bool headless = false;              // no window, surface or present, frames go to offscreen images
+        uint64_t frame_limit = 0;           // frames illuminate() draws before returning, 0 runs until quit
+        uint32_t capture_interval = 0;      // read back every Nth frame, 0 captures nothing
+        CAPTURE_FORMAT capture_format = CAPTURE_PNG;
+        const char* capture_path = "capture";
+        bool dynamic_resolution = false;    // render below swapchain size to hold the GPU frame time under budget
+        float frame_budget_ms = 8.0f;       // GPU time per frame dynamic resolution aims to stay under
+        float min_render_scale = 0.5f;      // lowest fraction of the swapchain extent it will drop to
+        const char* startup_report = nullptr;   // JSON file for the startup timings, logged when null
+        bool gpu_profiling = true;          // time the compute and graphics passes, dynamic resolution needs it either way
+        bool pipeline_statistics = false;   // count shader invocations and clipped primitives for the dispatch and draw
+        const char* trace_path = nullptr;   // Chrome trace of CPU and GPU scopes, nothing is traced when null
+        uint64_t trace_first_frame = 60;    // first frame of the traced window, past the warm up
+        uint64_t trace_frames = 120;        // frames the window holds
+        double frame_stats_interval = 10.0; // seconds between frame time summaries, 0 for only the one on exit
+        uint32_t particle_count = 499294;   // particles simulated and drawn, the storage is sized for the count at start up
+        uint32_t workgroup_size = 256;      // compute invocations per workgroup, specialized into the shader
+        uint32_t substeps = 1;              // orbit integration steps per dispatch, each deltaTime / substeps
+        float disk_speed = 0.3f;            // orbital speed the simulation pushes to the compute shader
+        const char* bench_path = nullptr;   // appends one result per run, CSV when it ends in .csv and JSON lines otherwise
+        uint64_t bench_warmup = 60;         // frames left out of the benchmark's statistics
+        HOST_ALLOCATOR_MODE host_allocator = HOST_ALLOCATOR_OFF;   // count the driver's host allocations, logged on exit
+        bool hud = false;                   // performance overlay drawn over the particles, H shows and hides it
+        const char* control_path = nullptr; // Unix socket for live statistics and runtime tuning, none when null
+    };
+
+// Feature structs chained for vkGetPhysicalDeviceFeatures2 and VkDeviceCreateInfo::pNext.
+// Extension structs are only linked when their extension is listed, and the list doubles as the
+// optional extensions to enable. chain() must be called again after a copy since the structs point at each other.
+struct DeviceFeatures
+    {
+        VkPhysicalDeviceFeatures2 core;
+        VkPhysicalDeviceVulkan12Features vulkan12;
+        VkPhysicalDeviceVulkan13Features vulkan13;
+        VkPhysicalDeviceExtendedDynamicStateFeaturesEXT dynamic_state;
+        VkPhysicalDeviceExtendedDynamicState2FeaturesEXT dynamic_state2;
+        VkPhysicalDeviceExtendedDynamicState3FeaturesEXT dynamic_state3;
+        VkPhysicalDeviceDescriptorBufferFeaturesEXT descriptor_buffer;
+        std::vector<const char*> extensions;
+
+        bool enabled(const char* extension) 
+            {
+                for (const char* _extension : extensions) 
+                    { if (strcmp(_extension, extension) == 0) { return true; } }
+
+                return false;
+            }
+
+        void chain(uint32_t api_version) 
+            {
+                core.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+                core.pNext = nullptr;
+                vulkan12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+                vulkan12.pNext = nullptr;
+                vulkan13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+                vulkan13.pNext = nullptr;
+                dynamic_state.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+                dynamic_state.pNext = nullptr;
+                dynamic_state2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT;
+                dynamic_state2.pNext = nullptr;
+                dynamic_state3.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT;
+                dynamic_state3.pNext = nullptr;
+                descriptor_buffer.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+                descriptor_buffer.pNext = nullptr;
+
+                auto _link = [this](void* feature) {
+                        reinterpret_cast<VkBaseOutStructure*>(feature)->pNext = reinterpret_cast<VkBaseOutStructure*>(core.pNext);
+                        core.pNext = feature;
+                    };
+
+                if (api_version >= VK_API_VERSION_1_2) { _link(&vulkan12); }
+                if (api_version >= VK_API_VERSION_1_3) { _link(&vulkan13); }
+                if (enabled(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME)) { _link(&dynamic_state); }
+                if (enabled(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME)) { _link(&dynamic_state2); }
+                if (enabled(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME)) { _link(&dynamic_state3); }
+                if (enabled(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME)) { _link(&descriptor_buffer); }
+            }
+    };
+
+// Extended dynamic state entry points, resolved once the logical device exists. Levels 1 and 2 point
+// at the core 1.3 commands where the device has them and at the EXT aliases otherwise.
+struct DynamicStateCommands
+    {
+        PFN_vkCmdSetPrimitiveTopology setPrimitiveTopology;
+        PFN_vkCmdSetCullMode setCullMode;
+        PFN_vkCmdSetFrontFace setFrontFace;
+        PFN_vkCmdSetDepthTestEnable setDepthTestEnable;
+        PFN_vkCmdSetDepthWriteEnable setDepthWriteEnable;
+        PFN_vkCmdSetDepthCompareOp setDepthCompareOp;
+        PFN_vkCmdSetPrimitiveRestartEnable setPrimitiveRestartEnable;
+        PFN_vkCmdSetColorBlendEnableEXT setColorBlendEnable;
+        PFN_vkCmdSetColorBlendEquationEXT setColorBlendEquation;
+        PFN_vkCmdSetColorWriteMaskEXT setColorWriteMask;
+        bool unrestricted_topology;         // topology may change class (points to triangles) without a new pipeline
+    };
+
+enum BLEND_MODE {
+    BLEND_ALPHA,
+    BLEND_ADDITIVE
+};
+
+// Rendering modes that can be switched at runtime. With extended dynamic state these are recorded
+// into the command buffer each frame, so changing one costs a command rather than a pipeline compile.
+struct RenderState
+    {
+        VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
+        VkCullModeFlags cull_mode = VK_CULL_MODE_BACK_BIT;
+        VkFrontFace front_face = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        bool depth_test = false;
+        bool depth_write = false;
+        VkCompareOp depth_compare = VK_COMPARE_OP_LESS;
+        BLEND_MODE blend = BLEND_ALPHA;
+    };
+
 struct DeletionQueue 
     {
         std::deque<std::function<void()>> deletors;
@@ -114,6 +266,24 @@ struct SwapChainDetails
         VkPresentModeKHR    present_mode;
     };
 
+struct ImageContext
+    {
+        VkImage image;
+        VkDeviceMemory memory;
+        VkImageView view;
+        VkSampler sampler;
+    };
+
+// A swapchain replaced by recreation. It lives until every frame that could still be using it has retired.
+struct RetiredSwapChain
+    {
+        VkSwapchainKHR instance;
+        std::vector<VkImageView> image_views;
+        std::vector<VkFramebuffer> framebuffers;
+        std::vector<ImageContext> render_targets;
+        uint64_t retire_frame;                  // first frame number at which it's safe to destroy
+    };
+
 struct SwapChainContext 
     {
         VkSwapchainKHR instance;
@@ -122,6 +292,7 @@ struct SwapChainContext
         std::vector<VkFramebuffer> framebuffers;
         SwapChainSupportDetails support;
         SwapChainDetails details;
+        std::deque<RetiredSwapChain> retired;
     };
 
 struct QueuePresentContext 
@@ -136,6 +307,19 @@ struct BufferContext
         VkDeviceMemory memory;
     };
 
+// One readback buffer in the capture ring. Pending until the frame that copied into it retires,
+// then free again once the writer thread has encoded it.
+struct CaptureSlot
+    {
+        BufferContext buffer = {};
+        void* mapped = nullptr;
+        VkDeviceSize size = 0;
+        VkExtent2D extent = {};
+        uint64_t frame = 0;
+        bool pending = false;
+        std::atomic<bool> free { true };
+    };
+
 
 struct MVP 
     {
@@ -144,25 +328,44 @@ struct MVP
         glm::mat4 proj;  // The projection matrix is the one that will be used to transform the vertices of the camera
     };
 
-struct UBO_T
+// Per-dispatch simulation parameters, pushed with the dispatch rather than written to a uniform buffer.
+// Matches the Push block in sq1.comp.
+struct SimulationParams
     {
         float deltaTime = 1.0f;
+        float time = 0.0f;
+        uint32_t seed = 0;
+        uint32_t emitter = 0;
+        uint32_t substeps = 1;          // orbit integration steps per dispatch
+        float disk_speed = 0.3f;
     };
 
 
-struct DescriptorContext
+// Push constant block for sq1_bindless.comp, the particle buffers are slots in the bindless table
+struct BindlessParticlePush
     {
-        VkDescriptorSetLayout layout;
-        VkDescriptorPool pool;
-        std::vector<VkDescriptorSet> sets;
+        uint32_t particles_in;
+        uint32_t particles_out;
+        SimulationParams simulation;
     };
 
-struct ImageContext
+// Push constant block for sq1.vert, as quads each particle is an instance this size in clip space
+struct ParticleDrawPush
     {
-        VkImage image;
-        VkDeviceMemory memory;
-        VkImageView view;
-        VkSampler sampler;
+        float quad_size[2];
+        uint32_t quads;
+    };
+
+// Push constant block for hud.vert, the quads are laid out in pixels of this extent
+struct HudPush
+    {
+        float extent[2];
+    };
+
+struct DescriptorContext
+    {
+        VkDescriptorSetLayout layout;
+        std::vector<VkDescriptorSet> sets;      // allocated through a DescriptorAllocator, which owns the pools
     };
 
 
@@ -0,0 +1,216 @@
+#include "bindless.h"
+#include "../pipeline/pipeline_descriptions.h"
+
+#include <array>
+
+static const VkDescriptorType _BINDLESS_DESCRIPTOR_TYPES[BINDLESS_TYPE_COUNT] = {
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+        VK_DESCRIPTOR_TYPE_SAMPLER
+    };
+
+static const char* _BINDLESS_TYPE_NAMES[BINDLESS_TYPE_COUNT] = { "Storage Buffers", "Sampled Images", "Samplers" };
+
+BindlessTable::BindlessTable()
+    {
+        report(LOGGER::VLINE, "\t .. Instantiating Bindless Table ..");
+        layout = VK_NULL_HANDLE;
+        set = VK_NULL_HANDLE;
+
+        for (Slots& _slot : _slots)
+            { _slot = { .capacity = 0, .next = 0, .free = {} }; }
+    }
+
+BindlessTable::~BindlessTable()
+    {
+        if (layout != VK_NULL_HANDLE)
+            { report(LOGGER::ERROR, "BindlessTable - Layout was never destroyed .."); }
+    }
+
+
+    //////////////
+    // CREATION //
+    //////////////
+
+void BindlessTable::create(VkDevice* logical_device, uint32_t buffer_ct, uint32_t image_ct, uint32_t sampler_ct)
+    {
+        report(LOGGER::VLINE, "\t .. Creating Bindless Table ..");
+
+        _slots[BINDLESS_STORAGE_BUFFER].capacity = buffer_ct;
+        _slots[BINDLESS_SAMPLED_IMAGE].capacity = image_ct;
+        _slots[BINDLESS_SAMPLER].capacity = sampler_ct;
+
+        std::array<VkDescriptorSetLayoutBinding, BINDLESS_TYPE_COUNT> _bindings;
+        std::array<VkDescriptorBindingFlags, BINDLESS_TYPE_COUNT> _binding_flags;
+
+        for (uint32_t i = 0; i < BINDLESS_TYPE_COUNT; i++)
+            {
+                report(LOGGER::VLINE, "\t\t .. Binding %u: %u %s ..", i, _slots[i].capacity, _BINDLESS_TYPE_NAMES[i]);
+
+                _bindings[i] = {
+                        .binding = i,
+                        .descriptorType = _BINDLESS_DESCRIPTOR_TYPES[i],
+                        .descriptorCount = _slots[i].capacity,
+                        .stageFlags = VK_SHADER_STAGE_ALL,
+                        .pImmutableSamplers = nullptr
+                    };
+
+                _binding_flags[i] = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+            }
+
+        _binding_flags[BINDLESS_TYPE_COUNT - 1] |= VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT;
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo _flags_info = {
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+                .pNext = nullptr,
+                .bindingCount = static_cast<uint32_t>(_binding_flags.size()),
+                .pBindingFlags = _binding_flags.data()
+            };
+
+        VkDescriptorSetLayoutCreateInfo _layout_info = {
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+                .pNext = &_flags_info,
+                .flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+                .bindingCount = static_cast<uint32_t>(_bindings.size()),
+                .pBindings = _bindings.data()
+            };
+
+        VK_TRY(vkCreateDescriptorSetLayout(*logical_device, &_layout_info, HOST_ALLOCATOR, &layout));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, layout, 0);
+        PipelineDescriptions::get().describeSetLayout(layout, _layout_info);
+
+        // One set, so the pool ratios are just the capacities
+        _allocator.init(logical_device, 1, {
+                { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, static_cast<float>(buffer_ct) },
+                { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, static_cast<float>(image_ct) },
+                { VK_DESCRIPTOR_TYPE_SAMPLER, static_cast<float>(sampler_ct) }
+            }, VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT);
+
+        VkDescriptorSetVariableDescriptorCountAllocateInfo _variable_info = {
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO,
+                .pNext = nullptr,
+                .descriptorSetCount = 1,
+                .pDescriptorCounts = &sampler_ct
+            };
+
+        set = _allocator.allocate(logical_device, layout, &_variable_info);
+
+        return;
+    }
+
+void BindlessTable::destroy(VkDevice* logical_device)
+    {
+        report(LOGGER::VLINE, "\t .. Destroying Bindless Table ..");
+
+        _allocator.destroy(logical_device);
+        RELEASE_OBJECT(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, layout);
+        PipelineDescriptions::get().forgetSetLayout(layout);
+        vkDestroyDescriptorSetLayout(*logical_device, layout, HOST_ALLOCATOR);
+        layout = VK_NULL_HANDLE;
+        set = VK_NULL_HANDLE;
+
+        return;
+    }
+
+
+    ///////////
+    // SLOTS //
+    ///////////
+
+uint32_t BindlessTable::_acquire(BINDLESS_TYPE type)
+    {
+        Slots& _slot = _slots[type];
+
+        if (!_slot.free.empty())
+            {
+                uint32_t _index = _slot.free.back();
+                _slot.free.pop_back();
+                return _index;
+            }
+
+        if (_slot.next >= _slot.capacity)
+            {
+                report(LOGGER::ERROR, "BindlessTable - Out of %s (%u) ..", _BINDLESS_TYPE_NAMES[type], _slot.capacity);
+                abort();
+            }
+
+        return _slot.next++;
+    }
+
+void BindlessTable::_write(VkDevice* logical_device, BINDLESS_TYPE type, uint32_t index, const VkDescriptorBufferInfo* buffer_info, const VkDescriptorImageInfo* image_info)
+    {
+        VkWriteDescriptorSet _write = {
+                .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .pNext = nullptr,
+                .dstSet = set,
+                .dstBinding = static_cast<uint32_t>(type),
+                .dstArrayElement = index,
+                .descriptorCount = 1,
+                .descriptorType = _BINDLESS_DESCRIPTOR_TYPES[type],
+                .pImageInfo = image_info,
+                .pBufferInfo = buffer_info,
+                .pTexelBufferView = nullptr
+            };
+
+        vkUpdateDescriptorSets(*logical_device, 1, &_write, 0, nullptr);
+
+        return;
+    }
+
+// The returned index is stable until release(), pass it to shaders through push constants
+uint32_t BindlessTable::registerBuffer(VkDevice* logical_device, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range)
+    {
+        std::lock_guard<std::mutex> _guard(_lock);
+
+        uint32_t _index = _acquire(BINDLESS_STORAGE_BUFFER);
+        VkDescriptorBufferInfo _buffer_info = { .buffer = buffer, .offset = offset, .range = range };
+        _write(logical_device, BINDLESS_STORAGE_BUFFER, _index, &_buffer_info, nullptr);
+
+        report(LOGGER::VLINE, "\t\t .. Registered Bindless Buffer %u ..", _index);
+        return _index;
+    }
+
+uint32_t BindlessTable::registerImage(VkDevice* logical_device, VkImageView view, VkImageLayout image_layout)
+    {
+        std::lock_guard<std::mutex> _guard(_lock);
+
+        uint32_t _index = _acquire(BINDLESS_SAMPLED_IMAGE);
+        VkDescriptorImageInfo _image_info = { .sampler = VK_NULL_HANDLE, .imageView = view, .imageLayout = image_layout };
+        _write(logical_device, BINDLESS_SAMPLED_IMAGE, _index, nullptr, &_image_info);
+
+        report(LOGGER::VLINE, "\t\t .. Registered Bindless Image %u ..", _index);
+        return _index;
+    }
+
+uint32_t BindlessTable::registerSampler(VkDevice* logical_device, VkSampler sampler)
+    {
+        std::lock_guard<std::mutex> _guard(_lock);
+
+        uint32_t _index = _acquire(BINDLESS_SAMPLER);
+        VkDescriptorImageInfo _image_info = { .sampler = sampler, .imageView = VK_NULL_HANDLE, .imageLayout = VK_IMAGE_LAYOUT_UNDEFINED };
+        _write(logical_device, BINDLESS_SAMPLER, _index, nullptr, &_image_info);
+
+        report(LOGGER::VLINE, "\t\t .. Registered Bindless Sampler %u ..", _index);
+        return _index;
+    }
+
+// The stale descriptor stays in the slot, partially bound means that's fine as long as no shader reads it.
+// Only release once the frames that used the index have retired, e.g. from a deletion queue.
+void BindlessTable::release(BINDLESS_TYPE type, uint32_t index)
+    {
+        std::lock_guard<std::mutex> _guard(_lock);
+        _slots[type].free.push_back(index);
+
+        return;
+    }
+
+void BindlessTable::log()
+    {
+        report(LOGGER::DEBUG, "\t .. Logging Bindless Table ..");
+
+        for (uint32_t i = 0; i < BINDLESS_TYPE_COUNT; i++)
+            {
+                report(LOGGER::DLINE, "\t\t%s: %u/%u in use", _BINDLESS_TYPE_NAMES[i], 
+                        _slots[i].next - static_cast<uint32_t>(_slots[i].free.size()), _slots[i].capacity);
+            }
+    }
@@ -0,0 +1,51 @@
+#pragma once
+#include "descriptor_allocator.h"
+
+#include <mutex>
+
+enum BINDLESS_TYPE {
+    BINDLESS_STORAGE_BUFFER,
+    BINDLESS_SAMPLED_IMAGE,
+    BINDLESS_SAMPLER,
+    BINDLESS_TYPE_COUNT
+};
+
+/*
+    The BindlessTable is a single descriptor set holding one array per resource type, bound once and
+    indexed from shaders. Resources register once and keep their slot until released, so a draw or
+    dispatch only needs to push the indices it reads. The set is update-after-bind and partially bound,
+    which lets registration happen while earlier frames still have it bound. Only the last binding
+    (samplers) can have a variable count, the others are allocated at their full capacity.
+*/
+
+class BindlessTable {
+    public:
+        VkDescriptorSetLayout layout;
+        VkDescriptorSet set;
+
+        BindlessTable();
+        ~BindlessTable();
+
+        void create(VkDevice*, uint32_t, uint32_t, uint32_t);
+        uint32_t registerBuffer(VkDevice*, VkBuffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+        uint32_t registerImage(VkDevice*, VkImageView, VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        uint32_t registerSampler(VkDevice*, VkSampler);
+        void release(BINDLESS_TYPE, uint32_t);
+        void destroy(VkDevice*);
+        void log();
+
+    private:
+        struct Slots 
+            {
+                uint32_t capacity;
+                uint32_t next;                  // first slot never handed out
+                std::vector<uint32_t> free;     // released slots, reused before next grows
+            };
+
+        Slots _slots[BINDLESS_TYPE_COUNT];
+        DescriptorAllocator _allocator;
+        std::mutex _lock;
+
+        uint32_t _acquire(BINDLESS_TYPE);
+        void _write(VkDevice*, BINDLESS_TYPE, uint32_t, const VkDescriptorBufferInfo*, const VkDescriptorImageInfo*);
+};
@@ -0,0 +1,177 @@
+#include "descriptor_allocator.h"
+
+#include <algorithm>
+
+constexpr uint32_t MAX_SETS_PER_POOL = 4092;
+constexpr float POOL_GROWTH = 1.5f;
+
+DescriptorAllocator::DescriptorAllocator()
+    {
+        report(LOGGER::VLINE, "\t .. Instantiating Descriptor Allocator ..");
+        _flags = 0;
+        _sets_per_pool = 0;
+        _allocations = 0;
+    }
+
+DescriptorAllocator::~DescriptorAllocator()
+    {
+        if (!_ready_pools.empty() || !_full_pools.empty())
+            { report(LOGGER::ERROR, "DescriptorAllocator - %zu pools were never destroyed ..", size()); }
+    }
+
+
+    ///////////
+    // POOLS //
+    ///////////
+
+VkDescriptorPool DescriptorAllocator::_createPool(VkDevice* logical_device, uint32_t set_ct)
+    {
+        report(LOGGER::VLINE, "\t\t .. Creating Descriptor Pool of %u Sets ..", set_ct);
+
+        std::vector<VkDescriptorPoolSize> _pool_sizes;
+        for (const PoolRatio& _ratio : _ratios)
+            {
+                _pool_sizes.push_back({
+                        .type = _ratio.type,
+                        .descriptorCount = static_cast<uint32_t>(_ratio.ratio * set_ct) + 1
+                    });
+            }
+
+        VkDescriptorPoolCreateInfo _pool_info = {
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+                .pNext = nullptr,
+                .flags = _flags,
+                .maxSets = set_ct,
+                .poolSizeCount = static_cast<uint32_t>(_pool_sizes.size()),
+                .pPoolSizes = _pool_sizes.data()
+            };
+
+        VkDescriptorPool _pool;
+        VK_TRY(vkCreateDescriptorPool(*logical_device, &_pool_info, HOST_ALLOCATOR, &_pool));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_DESCRIPTOR_POOL, _pool, 0);
+
+        return _pool;
+    }
+
+// Takes a pool with room left, or grows the chain by one
+VkDescriptorPool DescriptorAllocator::_getPool(VkDevice* logical_device)
+    {
+        if (!_ready_pools.empty())
+            {
+                VkDescriptorPool _pool = _ready_pools.back();
+                _ready_pools.pop_back();
+                return _pool;
+            }
+
+        VkDescriptorPool _pool = _createPool(logical_device, _sets_per_pool);
+        // At least one more, a pool of one set would otherwise round back down to one forever
+        uint32_t _grown = static_cast<uint32_t>(_sets_per_pool * POOL_GROWTH);
+        _sets_per_pool = std::min(std::max(_grown, _sets_per_pool + 1), MAX_SETS_PER_POOL);
+
+        return _pool;
+    }
+
+
+    ///////////////////
+    // ALLOCATOR API //
+    ///////////////////
+
+void DescriptorAllocator::init(VkDevice* logical_device, uint32_t initial_sets, std::vector<PoolRatio> ratios, VkDescriptorPoolCreateFlags flags)
+    {
+        report(LOGGER::VLINE, "\t .. Initializing Descriptor Allocator ..");
+
+        _ratios = ratios;
+        _flags = flags;
+        _sets_per_pool = std::max(initial_sets, 1u);
+        _ready_pools.push_back(_getPool(logical_device));
+
+        return;
+    }
+
+// A pool that is out of memory or too fragmented is parked and the allocation retried once on a fresh
+// pool. Failing twice means the layout doesn't fit any pool these ratios can build, which is a bug.
+VkDescriptorSet DescriptorAllocator::allocate(VkDevice* logical_device, VkDescriptorSetLayout layout, const void* pNext)
+    {
+        VkDescriptorPool _pool = _getPool(logical_device);
+
+        VkDescriptorSetAllocateInfo _alloc_info = {
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+                .pNext = pNext,
+                .descriptorPool = _pool,
+                .descriptorSetCount = 1,
+                .pSetLayouts = &layout
+            };
+
+        VkDescriptorSet _set;
+        VkResult _result = vkAllocateDescriptorSets(*logical_device, &_alloc_info, &_set);
+
+        if (_result == VK_ERROR_OUT_OF_POOL_MEMORY || _result == VK_ERROR_FRAGMENTED_POOL)
+            {
+                report(LOGGER::VLINE, "\t\t .. Descriptor Pool Exhausted, Chaining ..");
+                _full_pools.push_back(_pool);
+
+                _pool = _getPool(logical_device);
+                _alloc_info.descriptorPool = _pool;
+
+                VK_TRY(vkAllocateDescriptorSets(*logical_device, &_alloc_info, &_set));
+            }
+        else
+            { VK_TRY(_result); }
+
+        _ready_pools.push_back(_pool);
+        _allocations++;
+
+        return _set;
+    }
+
+// Frees every set from every pool at once, only call this when the GPU is done with all of them
+void DescriptorAllocator::reset(VkDevice* logical_device)
+    {
+        for (VkDescriptorPool _pool : _ready_pools)
+            { VK_TRY(vkResetDescriptorPool(*logical_device, _pool, 0)); }
+
+        for (VkDescriptorPool _pool : _full_pools)
+            {
+                VK_TRY(vkResetDescriptorPool(*logical_device, _pool, 0));
+                _ready_pools.push_back(_pool);
+            }
+
+        _full_pools.clear();
+        _allocations = 0;
+
+        return;
+    }
+
+void DescriptorAllocator::destroy(VkDevice* logical_device)
+    {
+        report(LOGGER::VLINE, "\t .. Destroying Descriptor Allocator ..");
+
+        for (VkDescriptorPool _pool : _ready_pools)
+            {
+                RELEASE_OBJECT(VK_OBJECT_TYPE_DESCRIPTOR_POOL, _pool);
+                vkDestroyDescriptorPool(*logical_device, _pool, HOST_ALLOCATOR);
+            }
+
+        for (VkDescriptorPool _pool : _full_pools)
+            {
+                RELEASE_OBJECT(VK_OBJECT_TYPE_DESCRIPTOR_POOL, _pool);
+                vkDestroyDescriptorPool(*logical_device, _pool, HOST_ALLOCATOR);
+            }
+
+        _ready_pools.clear();
+        _full_pools.clear();
+        _allocations = 0;
+
+        return;
+    }
+
+size_t DescriptorAllocator::size()
+    { return _ready_pools.size() + _full_pools.size(); }
+
+void DescriptorAllocator::log()
+    {
+        report(LOGGER::DEBUG, "\t .. Logging Descriptor Allocator ..");
+        report(LOGGER::DLINE, "\t\tPools: %zu (%zu full)", size(), _full_pools.size());
+        report(LOGGER::DLINE, "\t\tSets Allocated: %u", _allocations);
+        report(LOGGER::DLINE, "\t\tNext Pool Size: %u", _sets_per_pool);
+    }
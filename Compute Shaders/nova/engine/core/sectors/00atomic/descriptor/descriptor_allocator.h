@@ -0,0 +1,41 @@
+#pragma once
+#include "../atomic.h"
+
+#include <vector>
+
+/*
+    The DescriptorAllocator hands out descriptor sets from a chain of pools. When a pool runs out it
+    is parked as full and the next allocation comes from a fresh pool, each one larger than the last,
+    so adding sets never needs the pool sizes worked out up front. reset() returns every pool in one
+    call, which makes one allocator per frame in flight a cheap home for transient sets.
+*/
+
+class DescriptorAllocator {
+    public:
+        struct PoolRatio 
+            {
+                VkDescriptorType type;
+                float ratio;                    // descriptors of this type per set
+            };
+
+        DescriptorAllocator();
+        ~DescriptorAllocator();
+
+        void init(VkDevice*, uint32_t, std::vector<PoolRatio>, VkDescriptorPoolCreateFlags flags = 0);
+        VkDescriptorSet allocate(VkDevice*, VkDescriptorSetLayout, const void* pNext = nullptr);
+        void reset(VkDevice*);
+        void destroy(VkDevice*);
+        size_t size();
+        void log();
+
+    private:
+        std::vector<PoolRatio> _ratios;
+        std::vector<VkDescriptorPool> _ready_pools;
+        std::vector<VkDescriptorPool> _full_pools;
+        VkDescriptorPoolCreateFlags _flags;
+        uint32_t _sets_per_pool;
+        uint32_t _allocations;
+
+        VkDescriptorPool _getPool(VkDevice*);
+        VkDescriptorPool _createPool(VkDevice*, uint32_t);
+};
@@ -0,0 +1,230 @@
+#include "descriptor_binder.h"
+
+static inline VkDeviceSize _alignUp(VkDeviceSize size, VkDeviceSize alignment) 
+    { return alignment ? (size + alignment - 1) & ~(alignment - 1) : size; }
+
+DescriptorBinder::DescriptorBinder()
+    {
+        report(LOGGER::VLINE, "\t .. Instantiating Descriptor Binder ..");
+        backend = BINDING_DESCRIPTOR_SETS;
+        _device = VK_NULL_HANDLE;
+        _properties = {};
+        _buffer = {};
+        _mapped = nullptr;
+        _address = 0;
+        _region_size = 0;
+        _cmdPushDescriptorSet = nullptr;
+        _getLayoutSize = nullptr;
+        _getBindingOffset = nullptr;
+        _getDescriptor = nullptr;
+        _cmdBindDescriptorBuffers = nullptr;
+        _cmdSetDescriptorBufferOffsets = nullptr;
+    }
+
+DescriptorBinder::~DescriptorBinder()
+    { destroy(); }
+
+
+    ////////////////////
+    // INITIALIZATION //
+    ////////////////////
+
+void DescriptorBinder::init(VkDevice* logical_device, VkPhysicalDevice physical_device, BINDING_BACKEND binding_backend)
+    {
+        report(LOGGER::VLINE, "\t .. Initializing Descriptor Binder ..");
+
+        backend = binding_backend;
+        _device = *logical_device;
+
+        if (backend == BINDING_PUSH_DESCRIPTORS)
+            { _cmdPushDescriptorSet = (PFN_vkCmdPushDescriptorSetKHR)vkGetDeviceProcAddr(_device, "vkCmdPushDescriptorSetKHR"); }
+
+        if (backend == BINDING_DESCRIPTOR_BUFFER)
+            {
+                _getLayoutSize = (PFN_vkGetDescriptorSetLayoutSizeEXT)vkGetDeviceProcAddr(_device, "vkGetDescriptorSetLayoutSizeEXT");
+                _getBindingOffset = (PFN_vkGetDescriptorSetLayoutBindingOffsetEXT)vkGetDeviceProcAddr(_device, "vkGetDescriptorSetLayoutBindingOffsetEXT");
+                _getDescriptor = (PFN_vkGetDescriptorEXT)vkGetDeviceProcAddr(_device, "vkGetDescriptorEXT");
+                _cmdBindDescriptorBuffers = (PFN_vkCmdBindDescriptorBuffersEXT)vkGetDeviceProcAddr(_device, "vkCmdBindDescriptorBuffersEXT");
+                _cmdSetDescriptorBufferOffsets = (PFN_vkCmdSetDescriptorBufferOffsetsEXT)vkGetDeviceProcAddr(_device, "vkCmdSetDescriptorBufferOffsetsEXT");
+
+                _properties = { .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT, .pNext = nullptr };
+                VkPhysicalDeviceProperties2 _device_properties = { .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2, .pNext = &_properties };
+                vkGetPhysicalDeviceProperties2(physical_device, &_device_properties);
+
+                report(LOGGER::DLINE, "\t\tStorage Buffer Descriptor Size: %u", (uint32_t)_properties.storageBufferDescriptorSize);
+                report(LOGGER::DLINE, "\t\tDescriptor Buffer Offset Alignment: %u", (uint32_t)_properties.descriptorBufferOffsetAlignment);
+            }
+
+        return;
+    }
+
+VkDescriptorSetLayoutCreateFlags DescriptorBinder::layoutFlags()
+    {
+        switch (backend)
+            {
+                case BINDING_PUSH_DESCRIPTORS: return VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+                case BINDING_DESCRIPTOR_BUFFER: return VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+                default: return 0;
+            }
+    }
+
+VkPipelineCreateFlags DescriptorBinder::pipelineFlags()
+    { return backend == BINDING_DESCRIPTOR_BUFFER ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT : 0; }
+
+// Extra usage for buffers bound through the descriptor buffer, which addresses them by device address
+VkBufferUsageFlags DescriptorBinder::bufferUsage()
+    { return backend == BINDING_DESCRIPTOR_BUFFER ? VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT : 0; }
+
+
+    ///////////////////////
+    // DESCRIPTOR BUFFER //
+    ///////////////////////
+
+// Bytes one frame's copy of the layout takes up in the descriptor buffer
+VkDeviceSize DescriptorBinder::regionSize(VkDescriptorSetLayout layout)
+    {
+        VkDeviceSize _layout_size = 0;
+        _getLayoutSize(_device, layout, &_layout_size);
+
+        return _alignUp(_layout_size, _properties.descriptorBufferOffsetAlignment);
+    }
+
+void DescriptorBinder::attach(BufferContext buffer, void* mapped, VkDeviceSize region_size)
+    {
+        report(LOGGER::VLINE, "\t\t .. Attaching Descriptor Buffer ..");
+
+        _buffer = buffer;
+        _mapped = mapped;
+        _region_size = region_size;
+
+        VkBufferDeviceAddressInfo _address_info = {
+                .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+                .pNext = nullptr,
+                .buffer = _buffer.buffer
+            };
+
+        _address = vkGetBufferDeviceAddress(_device, &_address_info);
+
+        return;
+    }
+
+// Each frame in flight owns a region, so rewriting it only races frames whose fence we've already waited on
+void DescriptorBinder::_writeStorageBuffers(VkCommandBuffer command_buffer, VkPipelineBindPoint bind_point, VkPipelineLayout pipeline_layout, 
+                                            VkDescriptorSetLayout set_layout, uint32_t region, const VkDescriptorBufferInfo* buffers, uint32_t count)
+    {
+        VkDeviceSize _region_offset = region * _region_size;
+        char* _region = static_cast<char*>(_mapped) + _region_offset;
+
+        for (uint32_t i = 0; i < count; i++)
+            {
+                VkBufferDeviceAddressInfo _address_info = {
+                        .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+                        .pNext = nullptr,
+                        .buffer = buffers[i].buffer
+                    };
+
+                VkDescriptorAddressInfoEXT _descriptor_address = {
+                        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT,
+                        .pNext = nullptr,
+                        .address = vkGetBufferDeviceAddress(_device, &_address_info) + buffers[i].offset,
+                        .range = buffers[i].range,
+                        .format = VK_FORMAT_UNDEFINED
+                    };
+
+                VkDescriptorGetInfoEXT _get_info = {
+                        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT,
+                        .pNext = nullptr,
+                        .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                        .data = { .pStorageBuffer = &_descriptor_address }
+                    };
+
+                VkDeviceSize _binding_offset = 0;
+                _getBindingOffset(_device, set_layout, i, &_binding_offset);
+                _getDescriptor(_device, &_get_info, _properties.storageBufferDescriptorSize, _region + _binding_offset);
+            }
+
+        VkDescriptorBufferBindingInfoEXT _binding_info = {
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT,
+                .pNext = nullptr,
+                .address = _address,
+                .usage = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT
+            };
+
+        uint32_t _buffer_index = 0;
+        _cmdBindDescriptorBuffers(command_buffer, 1, &_binding_info);
+        _cmdSetDescriptorBufferOffsets(command_buffer, bind_point, pipeline_layout, 0, 1, &_buffer_index, &_region_offset);
+
+        return;
+    }
+
+
+    //////////////////////
+    // PUSH DESCRIPTORS //
+    //////////////////////
+
+void DescriptorBinder::_pushStorageBuffers(VkCommandBuffer command_buffer, VkPipelineBindPoint bind_point, VkPipelineLayout pipeline_layout, 
+                                           const VkDescriptorBufferInfo* buffers, uint32_t count)
+    {
+        std::array<VkWriteDescriptorSet, BINDER_MAX_BUFFERS> _writes;
+
+        for (uint32_t i = 0; i < count; i++)
+            {
+                _writes[i] = {
+                        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                        .pNext = nullptr,
+                        .dstSet = VK_NULL_HANDLE,   // ignored for push descriptors
+                        .dstBinding = i,
+                        .dstArrayElement = 0,
+                        .descriptorCount = 1,
+                        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                        .pImageInfo = nullptr,
+                        .pBufferInfo = &buffers[i],
+                        .pTexelBufferView = nullptr
+                    };
+            }
+
+        _cmdPushDescriptorSet(command_buffer, bind_point, pipeline_layout, 0, count, _writes.data());
+
+        return;
+    }
+
+
+    /////////////
+    // BINDING //
+    /////////////
+
+// Binds buffers[i] to binding i of set 0. region picks the frame's slice of the descriptor buffer.
+// Called per dispatch, so nothing here touches the heap.
+void DescriptorBinder::bindStorageBuffers(VkCommandBuffer command_buffer, VkPipelineBindPoint bind_point, VkPipelineLayout pipeline_layout, 
+                                          VkDescriptorSetLayout set_layout, uint32_t region, const VkDescriptorBufferInfo* buffers, uint32_t count)
+    {
+        if (count > BINDER_MAX_BUFFERS)
+            {
+                report(LOGGER::ERROR, "DescriptorBinder - Binding %u Buffers, at Most %u Fit ..", count, BINDER_MAX_BUFFERS);
+                return;
+            }
+
+        switch (backend)
+            {
+                case BINDING_PUSH_DESCRIPTORS: 
+                    _pushStorageBuffers(command_buffer, bind_point, pipeline_layout, buffers, count); 
+                    break;
+                case BINDING_DESCRIPTOR_BUFFER: 
+                    _writeStorageBuffers(command_buffer, bind_point, pipeline_layout, set_layout, region, buffers, count); 
+                    break;
+                default:
+                    report(LOGGER::ERROR, "DescriptorBinder - Backend binds through descriptor sets ..");
+                    break;
+            }
+
+        return;
+    }
+
+void DescriptorBinder::destroy()
+    {
+        _mapped = nullptr;
+        _buffer = {};
+        _address = 0;
+
+        return;
+    }
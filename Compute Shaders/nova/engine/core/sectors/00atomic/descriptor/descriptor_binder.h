@@ -0,0 +1,49 @@
+#pragma once
+#include "../atomic.h"
+
+#include <array>
+
+const uint32_t BINDER_MAX_BUFFERS = 8;      // storage buffers one bind can write, so the writes fit on the stack
+
+/*
+    The DescriptorBinder binds storage buffers to a set layout at record time for the backends that
+    don't need descriptor sets. Under push descriptors the writes go straight into the command buffer.
+    Under descriptor buffers they are written into a mapped, GPU visible buffer with one region per
+    frame in flight. Either way, rebinding different buffers per dispatch allocates and updates nothing.
+*/
+
+class DescriptorBinder {
+    public:
+        BINDING_BACKEND backend;
+
+        DescriptorBinder();
+        ~DescriptorBinder();
+
+        void init(VkDevice*, VkPhysicalDevice, BINDING_BACKEND);
+        VkDescriptorSetLayoutCreateFlags layoutFlags();
+        VkPipelineCreateFlags pipelineFlags();
+        VkBufferUsageFlags bufferUsage();
+        VkDeviceSize regionSize(VkDescriptorSetLayout);
+        void attach(BufferContext, void*, VkDeviceSize);
+        void bindStorageBuffers(VkCommandBuffer, VkPipelineBindPoint, VkPipelineLayout, VkDescriptorSetLayout, uint32_t, const VkDescriptorBufferInfo*, uint32_t);
+        void destroy();
+
+    private:
+        VkDevice _device;
+        VkPhysicalDeviceDescriptorBufferPropertiesEXT _properties;
+
+        BufferContext _buffer;              // descriptor buffer backing, owned by NovaCore
+        void* _mapped;
+        VkDeviceAddress _address;
+        VkDeviceSize _region_size;
+
+        PFN_vkCmdPushDescriptorSetKHR _cmdPushDescriptorSet;
+        PFN_vkGetDescriptorSetLayoutSizeEXT _getLayoutSize;
+        PFN_vkGetDescriptorSetLayoutBindingOffsetEXT _getBindingOffset;
+        PFN_vkGetDescriptorEXT _getDescriptor;
+        PFN_vkCmdBindDescriptorBuffersEXT _cmdBindDescriptorBuffers;
+        PFN_vkCmdSetDescriptorBufferOffsetsEXT _cmdSetDescriptorBufferOffsets;
+
+        void _pushStorageBuffers(VkCommandBuffer, VkPipelineBindPoint, VkPipelineLayout, const VkDescriptorBufferInfo*, uint32_t);
+        void _writeStorageBuffers(VkCommandBuffer, VkPipelineBindPoint, VkPipelineLayout, VkDescriptorSetLayout, uint32_t, const VkDescriptorBufferInfo*, uint32_t);
+};
@@ -1,6 +1,8 @@
 #include "genesis.h"
 #include "lexicon.h"
 #include <fstream>
+#include <filesystem>
+#include <cstdlib>
 
 #include <random>
 #include <ctime>
@@ -33,7 +35,40 @@ void genesis::createShaderModule(VkDevice* logical_device, std::vector<char>& co
                 .pCode = reinterpret_cast<const uint32_t*>(code.data())
             };
 
-        VK_TRY(vkCreateShaderModule(*logical_device, &_create_info, nullptr, shader_module));
+        VK_TRY(vkCreateShaderModule(*logical_device, &_create_info, HOST_ALLOCATOR, shader_module));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_SHADER_MODULE, *shader_module, 0);
+
+        return;
+    }
+
+// Builds the module from the embedded words, unless NOVA_SHADER_DIR holds a replacement .spv for development
+void genesis::createShaderModule(VkDevice* logical_device, const ShaderBlob& blob, VkShaderModule* shader_module)
+    {
+        const char* _override_dir = std::getenv(SHADER_OVERRIDE_ENV);
+
+        if (_override_dir != nullptr)
+            {
+                std::filesystem::path _override = std::filesystem::path(_override_dir) / blob.file;
+
+                if (std::filesystem::exists(_override))
+                    {
+                        report(LOGGER::VLINE, "\t\t .. Overriding %s from %s ..", blob.file, _override_dir);
+                        std::vector<char> _code = loadFile(_override.string());
+                        createShaderModule(logical_device, _code, shader_module);
+                        return;
+                    }
+            }
+
+        report(LOGGER::VLINE, "\t\t .. Creating Shader Module from Embedded %s (%016llx) ..", blob.file, (unsigned long long)blob.hash);
+
+        VkShaderModuleCreateInfo _create_info = {
+                .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+                .codeSize = blob.count * sizeof(uint32_t),
+                .pCode = blob.words
+            };
+
+        VK_TRY(vkCreateShaderModule(*logical_device, &_create_info, HOST_ALLOCATOR, shader_module));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_SHADER_MODULE, *shader_module, 0);
 
         return;
     }
@@ -47,14 +82,13 @@ static const glm::vec3 yellow = glm::vec3(1.0f, 1.0f, 0.0f);
 
 const int screen_height = 1200;
 
-void genesis::createParticles(std::vector<Particle>* particles)   
+void genesis::createParticles(std::vector<Particle>* particles, uint32_t particle_ct)   
     {
         std::default_random_engine random_engine((unsigned)time(nullptr));
         std::uniform_real_distribution<float> random_dist(0.0f, 1.0f);
-        int particle_ct = particles->size();
-        report(LOGGER::VLINE, "\t\t .. Creating %d Particles ..", particle_ct);
+        report(LOGGER::VLINE, "\t\t .. Creating %u Particles ..", particle_ct);
 
-        for (size_t i = 0; i < particle_ct; i++)
+        for (uint32_t i = 0; i < particle_ct; i++)
             {
                 Particle _particle = {
                     .position = {random_dist(random_engine) * 2.0f - 1.0f, random_dist(random_engine) * 2.0f - 1.0f},
@@ -5,13 +5,20 @@
 #include "vertex.h"
 #include "particle.h"
 
-const std::string vert_shader = "/home/persist/z/Ancillary/Big Stick Studios/repos/learning/Cpp/Vulkan/Compute Shaders/nova/engine/core/components/shaders/sq1_v.spv";
-const std::string frag_shader = "/home/persist/z/Ancillary/Big Stick Studios/repos/learning/Cpp/Vulkan/Compute Shaders/nova/engine/core/components/shaders/sq1_f.spv";
-const std::string comp_shader = "/home/persist/z/Ancillary/Big Stick Studios/repos/learning/Cpp/Vulkan/Compute Shaders/nova/engine/core/components/shaders/sq1_c.spv";
+#include "../../components/shaders/spirv.h"
+
+// SPIR-V is embedded at build time by components/shaders/shader_compute.sh
+constexpr const ShaderBlob& vert_shader = spirv::sq1_vert;
+constexpr const ShaderBlob& frag_shader = spirv::sq1_frag;
+constexpr const ShaderBlob& comp_shader = spirv::sq1_comp;
+constexpr const ShaderBlob& bindless_comp_shader = spirv::sq1_bindless_comp;
+constexpr const ShaderBlob& hud_vert_shader = spirv::hud_vert;
+constexpr const ShaderBlob& hud_frag_shader = spirv::hud_frag;
 
 namespace genesis {
     std::vector<char> loadFile(const std::string&);
     void createObjects(std::vector<Vertex>*, std::vector<uint32_t>*);
-    void createParticles(std::vector<Particle>*);
+    void createParticles(std::vector<Particle>*, uint32_t);
     void createShaderModule(VkDevice*, std::vector<char>&, VkShaderModule*);
+    void createShaderModule(VkDevice*, const ShaderBlob&, VkShaderModule*);
 }
\ No newline at end of file
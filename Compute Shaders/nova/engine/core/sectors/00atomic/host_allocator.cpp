@@ -0,0 +1,372 @@
+#include "host_allocator.h"
+#include "../../components/utility/logger.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+const size_t HOST_POOL_BLOCK_MIN = 64;          // smallest size class, each one after doubles it
+const uint8_t HOST_POOL_CLASS_CT = 7;           // 64 bytes up to 4 KiB, anything bigger goes to malloc
+const size_t HOST_POOL_SLAB_SIZE = 64 * 1024;   // carved into one size class at a time, never handed back
+
+static const char* _SCOPES[HOST_SCOPE_CT] = { "Command", "Object", "Cache", "Device", "Instance" };
+
+// Sits right in front of every block handed to the driver. malloc's blocks and the pool's
+// are 16 byte aligned, so is the header whatever alignment the driver asked for.
+struct AllocationHeader
+    {
+        uint64_t size;
+        uint32_t offset;                // from the start of the underlying block
+        uint16_t site;
+        uint8_t scope;
+        uint8_t size_class;             // HOST_POOL_CLASS_CT when it came from malloc
+    };
+
+static_assert(sizeof(AllocationHeader) == 16, "AllocationHeader must keep 16 byte alignment");
+
+
+    //////////
+    // POOL //
+    //////////
+
+// Free blocks are linked through their first word
+struct HostPool
+    {
+        std::mutex mutex;
+        void* free[HOST_POOL_CLASS_CT] = {};
+    };
+
+static HostPool& _getPool()
+    {
+        static HostPool _pool;
+        return _pool;
+    }
+
+// A thread's blocks go back to the shared lists when it exits, so a short lived driver thread doesn't strand them
+struct PoolCache
+    {
+        void* free[HOST_POOL_CLASS_CT] = {};
+
+        ~PoolCache()
+            {
+                HostPool& _pool = _getPool();
+                std::lock_guard<std::mutex> _lock(_pool.mutex);
+
+                for (uint8_t c = 0; c < HOST_POOL_CLASS_CT; c++)
+                    {
+                        while (free[c] != nullptr)
+                            {
+                                void* _block = free[c];
+                                free[c] = *(void**)_block;
+                                *(void**)_block = _pool.free[c];
+                                _pool.free[c] = _block;
+                            }
+                    }
+            }
+    };
+
+static thread_local PoolCache _cache;
+
+static inline size_t _getClassSize(uint8_t size_class)
+    { return HOST_POOL_BLOCK_MIN << size_class; }
+
+static inline uint8_t _getClass(size_t bytes)
+    {
+        uint8_t _class = 0;
+        while (_class < HOST_POOL_CLASS_CT && _getClassSize(_class) < bytes) { _class++; }
+
+        return _class;
+    }
+
+// The thread's own list first, then the whole shared list, then a fresh slab
+static void* _takeBlock(uint8_t size_class)
+    {
+        if (_cache.free[size_class] == nullptr)
+            {
+                HostPool& _pool = _getPool();
+                std::lock_guard<std::mutex> _lock(_pool.mutex);
+
+                if (_pool.free[size_class] != nullptr)
+                    {
+                        _cache.free[size_class] = _pool.free[size_class];
+                        _pool.free[size_class] = nullptr;
+                    }
+                else
+                    {
+                        char* _slab = (char*)malloc(HOST_POOL_SLAB_SIZE);
+                        if (_slab == nullptr) { return nullptr; }
+
+                        size_t _size = _getClassSize(size_class);
+                        for (size_t _at = 0; _at + _size <= HOST_POOL_SLAB_SIZE; _at += _size)
+                            {
+                                *(void**)(_slab + _at) = _cache.free[size_class];
+                                _cache.free[size_class] = _slab + _at;
+                            }
+                    }
+            }
+
+        void* _block = _cache.free[size_class];
+        _cache.free[size_class] = *(void**)_block;
+
+        return _block;
+    }
+
+// Onto whichever thread frees it, the driver often frees on another thread than it allocated on
+static void _giveBlock(uint8_t size_class, void* block)
+    {
+        *(void**)block = _cache.free[size_class];
+        _cache.free[size_class] = block;
+
+        return;
+    }
+
+
+    ////////////////////
+    // HOST ALLOCATOR //
+    ////////////////////
+
+HostAllocator& HostAllocator::get()
+    {
+        static HostAllocator _allocator;
+        return _allocator;
+    }
+
+HostAllocator::HostAllocator()
+    {
+        _mode = HOST_ALLOCATOR_OFF;
+        _site_ct = 0;
+        _in_frame = false;
+        _frame_allocations = 0;
+
+        for (uint32_t i = 0; i < MAX_ALLOCATION_SITES; i++)
+            {
+                Site& _site = _sites[i];
+                _site.name = i == MAX_ALLOCATION_SITES - 1 ? "(other)" : nullptr;
+                _site.callbacks = {
+                        .pUserData = &_site,
+                        .pfnAllocation = _allocate,
+                        .pfnReallocation = _reallocate,
+                        .pfnFree = _free,
+                        .pfnInternalAllocation = _internalAllocation,
+                        .pfnInternalFree = _internalFree
+                    };
+                _site.counters.allocations = 0;
+                _site.counters.frees = 0;
+                _site.counters.live_bytes = 0;
+                _site.counters.peak_bytes = 0;
+                _site.frame_allocations = 0;
+            }
+
+        for (uint32_t i = 0; i < HOST_SCOPE_CT; i++)
+            {
+                _scopes[i].allocations = 0;
+                _scopes[i].frees = 0;
+                _scopes[i].live_bytes = 0;
+                _scopes[i].peak_bytes = 0;
+                _internal_bytes[i] = 0;
+            }
+    }
+
+// Before vkCreateInstance, objects must be destroyed with callbacks compatible with those they were made with
+void HostAllocator::configure(HOST_ALLOCATOR_MODE mode)
+    {
+        _mode = mode;
+
+        if (mode == HOST_ALLOCATOR_TRACK)
+            { report(LOGGER::INFO, "HostAllocator - Tracking Host Allocations .."); }
+        else if (mode == HOST_ALLOCATOR_POOL)
+            { report(LOGGER::INFO, "HostAllocator - Tracking Host Allocations From a Pool .."); }
+
+        return;
+    }
+
+// Sites are only ever added, so lookups read without the lock up to the count last published
+const VkAllocationCallbacks* HostAllocator::callbacks(const char* site)
+    {
+        if (_mode == HOST_ALLOCATOR_OFF) { return nullptr; }
+
+        uint32_t _site_count = _site_ct.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < _site_count; i++)
+            { if (strcmp(_sites[i].name, site) == 0) { return &_sites[i].callbacks; } }
+
+        std::lock_guard<std::mutex> _lock(_mutex);
+
+        _site_count = _site_ct.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < _site_count; i++)
+            { if (strcmp(_sites[i].name, site) == 0) { return &_sites[i].callbacks; } }
+
+        if (_site_count == MAX_ALLOCATION_SITES - 1)
+            { return &_sites[MAX_ALLOCATION_SITES - 1].callbacks; }
+
+        _sites[_site_count].name = site;
+        _site_ct.store(_site_count + 1, std::memory_order_release);
+
+        return &_sites[_site_count].callbacks;
+    }
+
+static inline void _countBytes(std::atomic<uint64_t>& allocations, std::atomic<uint64_t>& live_bytes, std::atomic<uint64_t>& peak_bytes, size_t size)
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        uint64_t _live = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+        uint64_t _peak = peak_bytes.load(std::memory_order_relaxed);
+
+        while (_live > _peak && !peak_bytes.compare_exchange_weak(_peak, _live, std::memory_order_relaxed)) {}
+
+        return;
+    }
+
+void HostAllocator::_count(Site* site, VkSystemAllocationScope scope, size_t size)
+    {
+        _countBytes(site->counters.allocations, site->counters.live_bytes, site->counters.peak_bytes, size);
+        _countBytes(_scopes[scope].allocations, _scopes[scope].live_bytes, _scopes[scope].peak_bytes, size);
+
+        if (!_in_frame.load(std::memory_order_relaxed)) { return; }
+
+        _frame_allocations.fetch_add(1, std::memory_order_relaxed);
+
+        if (site->frame_allocations.fetch_add(1, std::memory_order_relaxed) == 0)
+            {
+                report(LOGGER::INFO, "HostAllocator - %zu Bytes of %s Scope Allocated Inside drawFrame, Through %s ..",
+                        size, _SCOPES[scope], site->name);
+            }
+
+        return;
+    }
+
+void HostAllocator::_uncount(uint32_t site, VkSystemAllocationScope scope, size_t size)
+    {
+        _sites[site].counters.frees.fetch_add(1, std::memory_order_relaxed);
+        _sites[site].counters.live_bytes.fetch_sub(size, std::memory_order_relaxed);
+        _scopes[scope].frees.fetch_add(1, std::memory_order_relaxed);
+        _scopes[scope].live_bytes.fetch_sub(size, std::memory_order_relaxed);
+
+        return;
+    }
+
+
+    ///////////////
+    // CALLBACKS //
+    ///////////////
+
+void* VKAPI_PTR HostAllocator::_allocate(void* user_data, size_t size, size_t alignment, VkSystemAllocationScope scope)
+    {
+        if (size == 0) { return nullptr; }
+
+        HostAllocator& _self = get();
+        Site* _site = (Site*)user_data;
+
+        if (alignment < 1) { alignment = 1; }
+        size_t _need = size + sizeof(AllocationHeader) + alignment - 1;
+        uint8_t _class = _self._mode == HOST_ALLOCATOR_POOL ? _getClass(_need) : HOST_POOL_CLASS_CT;
+
+        char* _block = (char*)(_class < HOST_POOL_CLASS_CT ? _takeBlock(_class) : malloc(_need));
+        if (_block == nullptr) { return nullptr; }
+
+        uintptr_t _memory = ((uintptr_t)_block + sizeof(AllocationHeader) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        AllocationHeader* _header = (AllocationHeader*)_memory - 1;
+
+        _header->size = size;
+        _header->offset = (uint32_t)(_memory - (uintptr_t)_block);
+        _header->site = (uint16_t)(_site - _self._sites);
+        _header->scope = (uint8_t)scope;
+        _header->size_class = _class;
+
+        _self._count(_site, scope, size);
+
+        return (void*)_memory;
+    }
+
+// Vulkan's rules: no original is an allocation, a zero size is a free, a failure leaves the original alone
+void* VKAPI_PTR HostAllocator::_reallocate(void* user_data, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope)
+    {
+        if (original == nullptr) { return _allocate(user_data, size, alignment, scope); }
+
+        if (size == 0)
+            {
+                _free(user_data, original);
+                return nullptr;
+            }
+
+        void* _memory = _allocate(user_data, size, alignment, scope);
+        if (_memory == nullptr) { return nullptr; }
+
+        AllocationHeader* _header = (AllocationHeader*)original - 1;
+        memcpy(_memory, original, std::min<size_t>(_header->size, size));
+        _free(user_data, original);
+
+        return _memory;
+    }
+
+// The header says where the block came from, the site it's freed through may not be the one it was made through
+void VKAPI_PTR HostAllocator::_free(void*, void* memory)
+    {
+        if (memory == nullptr) { return; }
+
+        AllocationHeader* _header = (AllocationHeader*)memory - 1;
+        get()._uncount(_header->site, (VkSystemAllocationScope)_header->scope, _header->size);
+
+        char* _block = (char*)memory - _header->offset;
+
+        if (_header->size_class < HOST_POOL_CLASS_CT) { _giveBlock(_header->size_class, _block); }
+        else { free(_block); }
+
+        return;
+    }
+
+// Executable memory the driver got for itself, all that's known is how much
+void VKAPI_PTR HostAllocator::_internalAllocation(void*, size_t size, VkInternalAllocationType, VkSystemAllocationScope scope)
+    {
+        get()._internal_bytes[scope].fetch_add(size, std::memory_order_relaxed);
+        return;
+    }
+
+void VKAPI_PTR HostAllocator::_internalFree(void*, size_t size, VkInternalAllocationType, VkSystemAllocationScope scope)
+    {
+        get()._internal_bytes[scope].fetch_sub(size, std::memory_order_relaxed);
+        return;
+    }
+
+
+    ///////////
+    // USAGE //
+    ///////////
+
+// Logged after the instance is gone, whatever is still live was never freed
+void HostAllocator::log()
+    {
+        if (_mode == HOST_ALLOCATOR_OFF) { return; }
+
+        report(LOGGER::INFO, "HostAllocator - Host Allocations by Scope ..");
+
+        for (uint32_t i = 0; i < HOST_SCOPE_CT; i++)
+            {
+                Counters& _scope = _scopes[i];
+                if (_scope.allocations == 0 && _internal_bytes[i] == 0) { continue; }
+
+                report(LOGGER::ILINE, "\t%-10s %8llu allocs  %8llu frees  %9.1f KB live  %9.1f KB peak  %9.1f KB internal",
+                        _SCOPES[i], (unsigned long long)_scope.allocations.load(), (unsigned long long)_scope.frees.load(),
+                        _scope.live_bytes.load() / 1024.0, _scope.peak_bytes.load() / 1024.0, (int64_t)_internal_bytes[i].load() / 1024.0);
+            }
+
+        std::vector<Site*> _busiest;
+        for (uint32_t i = 0; i < MAX_ALLOCATION_SITES; i++)
+            { if (_sites[i].counters.allocations > 0) { _busiest.push_back(&_sites[i]); } }
+
+        std::sort(_busiest.begin(), _busiest.end(), [](Site* a, Site* b) { return a->counters.allocations > b->counters.allocations; });
+
+        report(LOGGER::INFO, "HostAllocator - Host Allocations by Call Site ..");
+
+        for (Site* _site : _busiest)
+            {
+                report(LOGGER::ILINE, "\t%-32s %8llu allocs  %9.1f KB peak  %9.1f KB live  %8llu in frame",
+                        _site->name, (unsigned long long)_site->counters.allocations.load(), _site->counters.peak_bytes.load() / 1024.0,
+                        _site->counters.live_bytes.load() / 1024.0, (unsigned long long)_site->frame_allocations.load());
+            }
+
+        uint64_t _in_frame = _frame_allocations.load();
+        if (_in_frame) { report(LOGGER::INFO, "HostAllocator - %llu Allocations Inside drawFrame ..", (unsigned long long)_in_frame); }
+        else { report(LOGGER::INFO, "HostAllocator - No Allocations Inside drawFrame .."); }
+
+        return;
+    }
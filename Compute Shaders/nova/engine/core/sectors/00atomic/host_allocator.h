@@ -0,0 +1,83 @@
+#pragma once
+#include <vulkan/vulkan.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+enum HOST_ALLOCATOR_MODE {
+    HOST_ALLOCATOR_OFF,             // the driver's own allocator, every call site passes nullptr
+    HOST_ALLOCATOR_TRACK,           // counted, backed by malloc
+    HOST_ALLOCATOR_POOL             // counted, small blocks come from per-thread free lists
+};
+
+const uint32_t MAX_ALLOCATION_SITES = 64;       // call sites tracked by name, the rest share the last
+const uint32_t HOST_SCOPE_CT = VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE + 1;
+
+/*
+    The HostAllocator hands the driver VkAllocationCallbacks that count what it allocates on the
+    host, by VkSystemAllocationScope and by the function that created the object. Every create and
+    destroy passes HOST_ALLOCATOR, which is nullptr unless a mode was configured before the instance
+    was made. Anything allocated while a HostFrameScope is alive, the whole of drawFrame, is counted
+    against its site and reported the first time each site does it. The pool mode serves blocks of
+    up to 4 KiB from thread local free lists so driver threads don't queue on malloc's locks.
+*/
+
+class HostAllocator {
+    public:
+        static HostAllocator& get();
+
+        void configure(HOST_ALLOCATOR_MODE);
+        bool enabled() { return _mode != HOST_ALLOCATOR_OFF; }
+        const VkAllocationCallbacks* callbacks(const char*);
+        void enterFrame() { _in_frame.store(true, std::memory_order_relaxed); }
+        void leaveFrame() { _in_frame.store(false, std::memory_order_relaxed); }
+        uint64_t frameAllocations() { return _frame_allocations.load(std::memory_order_relaxed); }
+        void log();
+
+    private:
+        struct Counters
+            {
+                std::atomic<uint64_t> allocations;
+                std::atomic<uint64_t> frees;
+                std::atomic<uint64_t> live_bytes;
+                std::atomic<uint64_t> peak_bytes;
+            };
+
+        struct Site
+            {
+                const char* name;
+                VkAllocationCallbacks callbacks;    // pUserData points back at the site
+                Counters counters;
+                std::atomic<uint64_t> frame_allocations;
+            };
+
+        HOST_ALLOCATOR_MODE _mode;
+        Site _sites[MAX_ALLOCATION_SITES];
+        std::atomic<uint32_t> _site_ct;
+        std::mutex _mutex;                          // only taken to register a site
+        Counters _scopes[HOST_SCOPE_CT];
+        std::atomic<uint64_t> _internal_bytes[HOST_SCOPE_CT];
+        std::atomic<bool> _in_frame;
+        std::atomic<uint64_t> _frame_allocations;
+
+        HostAllocator();
+
+        void _count(Site*, VkSystemAllocationScope, size_t);
+        void _uncount(uint32_t, VkSystemAllocationScope, size_t);
+
+        static void* VKAPI_PTR _allocate(void*, size_t, size_t, VkSystemAllocationScope);
+        static void* VKAPI_PTR _reallocate(void*, void*, size_t, size_t, VkSystemAllocationScope);
+        static void VKAPI_PTR _free(void*, void*);
+        static void VKAPI_PTR _internalAllocation(void*, size_t, VkInternalAllocationType, VkSystemAllocationScope);
+        static void VKAPI_PTR _internalFree(void*, size_t, VkInternalAllocationType, VkSystemAllocationScope);
+};
+
+class HostFrameScope {
+    public:
+        HostFrameScope() { HostAllocator::get().enterFrame(); }
+        ~HostFrameScope() { HostAllocator::get().leaveFrame(); }
+};
+
+// Tagged with the enclosing function, creates and their destroys needn't share a site
+#define HOST_ALLOCATOR HostAllocator::get().callbacks(__func__)
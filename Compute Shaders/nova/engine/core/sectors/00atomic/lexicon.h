@@ -2,6 +2,8 @@
 #include <vulkan/vulkan.h>
 #include <vulkan/vk_enum_string_helper.h>
 #include "../../components/utility/logger.h"
+#include "host_allocator.h"
+#include "object_registry.h"
 #include <stdio.h>
 #include <cstdlib>
 
@@ -9,6 +11,7 @@
     do {                                                                    \
         VkResult err = x;                                                   \
         if (err) {                                                          \
+            flushLog();                                                     \
             fprintf(stderr, " [ERROR] Vulkan: %s\n", string_VkResult(err));  \
             abort();                                                        \
         }                                                                   \
@@ -0,0 +1,150 @@
+#include "object_registry.h"
+#include "../../components/utility/logger.h"
+
+#include <vulkan/vk_enum_string_helper.h>
+
+// VK_OBJECT_TYPE_IMAGE_VIEW reads as IMAGE_VIEW
+static inline const char* _getTypeName(VkObjectType type)
+    { return string_VkObjectType(type) + sizeof("VK_OBJECT_TYPE_") - 1; }
+
+ObjectRegistry& ObjectRegistry::get()
+    {
+        static ObjectRegistry _registry;
+        return _registry;
+    }
+
+ObjectRegistry::ObjectRegistry()
+    {
+        _frame = 0;
+        _stale = 0;
+    }
+
+void ObjectRegistry::add(VkObjectType type, uint64_t handle, VkDeviceSize size, const char* creator)
+    {
+        if (handle == 0) { return; }
+
+        std::lock_guard<std::mutex> _lock(_mutex);
+
+        uint64_t _frame_number = _frame.load(std::memory_order_relaxed);
+        auto [_entry, _added] = _objects.insert({ { type, handle }, { .size = size, .creator = creator, .frame = _frame_number } });
+
+        if (!_added)
+            {
+                _stale++;
+                report(LOGGER::ERROR, "ObjectRegistry - %s Registered %s %016llx, Still Registered by %s at Frame %llu ..",
+                        creator, _getTypeName(type), (unsigned long long)handle, _entry->second.creator,
+                        (unsigned long long)_entry->second.frame);
+                return;
+            }
+
+        auto _found = _categories.find(type);
+        if (_found == _categories.end())
+            { _found = _categories.insert({ type, { .type = type, .live = 0, .peak = 0, .created = 0, .marked = 0, .bytes = 0 } }).first; }
+
+        ObjectCategory& _category = _found->second;
+        _category.live++;
+        _category.created++;
+        _category.bytes += size;
+        if (_category.live > _category.peak) { _category.peak = _category.live; }
+
+        return;
+    }
+
+// Destroying VK_NULL_HANDLE is legal and does nothing, so it isn't stale
+void ObjectRegistry::remove(VkObjectType type, uint64_t handle, const char* destroyer)
+    {
+        if (handle == 0) { return; }
+
+        std::lock_guard<std::mutex> _lock(_mutex);
+
+        auto _entry = _objects.find({ type, handle });
+
+        if (_entry == _objects.end())
+            {
+                _stale++;
+                report(LOGGER::ERROR, "ObjectRegistry - %s Destroyed %s %016llx, Never Created or Already Destroyed ..",
+                        destroyer, _getTypeName(type), (unsigned long long)handle);
+                return;
+            }
+
+        ObjectCategory& _category = _categories[type];
+        _category.live--;
+        _category.bytes -= _entry->second.size;
+
+        _objects.erase(_entry);
+
+        return;
+    }
+
+std::vector<ObjectCategory> ObjectRegistry::categories()
+    {
+        std::lock_guard<std::mutex> _lock(_mutex);
+
+        std::vector<ObjectCategory> _list;
+        for (const auto& [_type, _category] : _categories) { _list.push_back(_category); }
+
+        return _list;
+    }
+
+uint64_t ObjectRegistry::live()
+    {
+        std::lock_guard<std::mutex> _lock(_mutex);
+        return _objects.size();
+    }
+
+// What log() measures growth against
+void ObjectRegistry::mark()
+    {
+        std::lock_guard<std::mutex> _lock(_mutex);
+
+        for (auto& [_type, _category] : _categories) { _category.marked = _category.live; }
+
+        return;
+    }
+
+void ObjectRegistry::log()
+    {
+        std::vector<ObjectCategory> _list = categories();
+        if (_list.empty()) { return; }
+
+        report(LOGGER::INFO, "ObjectRegistry - %llu Live Objects at Frame %llu ..",
+                (unsigned long long)live(), (unsigned long long)_frame.load(std::memory_order_relaxed));
+
+        for (const ObjectCategory& _category : _list)
+            {
+                if (_category.created == 0) { continue; }
+
+                report(LOGGER::ILINE, "\t%-24s %6llu live  %+6lld since mark  %6llu peak  %8llu created  %10.2f MB",
+                        _getTypeName(_category.type), (unsigned long long)_category.live,
+                        (long long)_category.live - (long long)_category.marked, (unsigned long long)_category.peak,
+                        (unsigned long long)_category.created, _category.bytes / (1024.0 * 1024.0));
+            }
+
+        return;
+    }
+
+// Once everything has been torn down, each object left is one nothing destroyed
+void ObjectRegistry::logLeaks()
+    {
+        std::lock_guard<std::mutex> _lock(_mutex);
+
+        if (_objects.empty() && _stale == 0)
+            {
+                report(LOGGER::INFO, "ObjectRegistry - No Leaked or Stale Handles ..");
+                return;
+            }
+
+        if (_stale) { report(LOGGER::INFO, "ObjectRegistry - %llu Stale Handles Were Destroyed or Registered ..", (unsigned long long)_stale); }
+        if (_objects.empty()) { return; }
+
+        report(LOGGER::INFO, "ObjectRegistry - %zu Objects Leaked ..", _objects.size());
+
+        for (const auto& [_key, _record] : _objects)
+            {
+                report(LOGGER::ILINE, "\t%-24s %016llx  from %s at frame %llu  %10.2f MB",
+                        _getTypeName(_key.first), (unsigned long long)_key.second, _record.creator,
+                        (unsigned long long)_record.frame, _record.size / (1024.0 * 1024.0));
+            }
+
+        return;
+    }
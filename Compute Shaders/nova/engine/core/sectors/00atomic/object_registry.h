@@ -0,0 +1,62 @@
+#pragma once
+#include <vulkan/vulkan.h>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+struct ObjectCategory
+    {
+        VkObjectType type;
+        uint64_t live;
+        uint64_t peak;
+        uint64_t created;
+        uint64_t marked;                // live when mark() was last called
+        VkDeviceSize bytes;             // memory the live objects asked for, where it's known
+    };
+
+/*
+    The ObjectRegistry keeps every Vulkan handle the engine creates, with its type, the memory it
+    asked for, the function that created it and the frame it was created in. REGISTER_OBJECT goes
+    right after a create and RELEASE_OBJECT right before the matching destroy, anything released
+    that was never registered, or released twice, is reported where it happened. Counts and bytes
+    per type are kept as objects come and go, log() compares them with the mark() taken once the
+    first frame is out, so growth over a long session stands out, and logLeaks() lists whatever is
+    still registered once the instance is gone. Creation is off the frame path, one lock is plenty.
+*/
+
+class ObjectRegistry {
+    public:
+        static ObjectRegistry& get();
+
+        void frame(uint64_t frame_number) { _frame.store(frame_number, std::memory_order_relaxed); }
+        void add(VkObjectType, uint64_t, VkDeviceSize, const char*);
+        void remove(VkObjectType, uint64_t, const char*);
+        std::vector<ObjectCategory> categories();
+        uint64_t live();
+        void mark();
+        void log();
+        void logLeaks();
+
+    private:
+        struct Record
+            {
+                VkDeviceSize size;
+                const char* creator;
+                uint64_t frame;
+            };
+
+        std::mutex _mutex;
+        std::map<std::pair<VkObjectType, uint64_t>, Record> _objects;     // handles are only unique within a type
+        std::map<VkObjectType, ObjectCategory> _categories;
+        std::atomic<uint64_t> _frame;
+        uint64_t _stale;
+
+        ObjectRegistry();
+};
+
+#define REGISTER_OBJECT(type, handle, size) ObjectRegistry::get().add(type, (uint64_t)(handle), size, __func__)
+#define RELEASE_OBJECT(type, handle) ObjectRegistry::get().remove(type, (uint64_t)(handle), __func__)
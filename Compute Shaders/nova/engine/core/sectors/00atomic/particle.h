@@ -10,27 +10,37 @@ struct Particle {
     glm::vec2 velocity;
     glm::vec4 color;
 
-    static VkVertexInputBindingDescription getBindingDescription() {
-        VkVertexInputBindingDescription bindingDescription = {};
-        bindingDescription.binding = 0;
-        bindingDescription.stride = sizeof(Particle);
-        bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    // The same buffer is bound twice: per vertex when drawn as points, per instance when each
+    // particle is drawn as a six vertex quad. The shader reads whichever the draw asked for.
+    static std::array<VkVertexInputBindingDescription, 2> getBindingDescriptions() {
+        std::array<VkVertexInputBindingDescription, 2> bindingDescriptions = {};
 
-        return bindingDescription;
-    }
+        bindingDescriptions[0].binding = 0;
+        bindingDescriptions[0].stride = sizeof(Particle);
+        bindingDescriptions[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
-    static std::array<VkVertexInputAttributeDescription, 2> getAttributeDescriptions() {
-        std::array<VkVertexInputAttributeDescription, 2> attributeDescriptions = {};
+        bindingDescriptions[1].binding = 1;
+        bindingDescriptions[1].stride = sizeof(Particle);
+        bindingDescriptions[1].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
 
-        attributeDescriptions[0].binding = 0;
-        attributeDescriptions[0].location = 0;
-        attributeDescriptions[0].format = VK_FORMAT_R32G32_SFLOAT;
-        attributeDescriptions[0].offset = offsetof(Particle, position);
+        return bindingDescriptions;
+    }
 
-        attributeDescriptions[1].binding = 0;
-        attributeDescriptions[1].location = 1;
-        attributeDescriptions[1].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-        attributeDescriptions[1].offset = offsetof(Particle, color);
+    static std::array<VkVertexInputAttributeDescription, 4> getAttributeDescriptions() {
+        std::array<VkVertexInputAttributeDescription, 4> attributeDescriptions = {};
+
+        for (uint32_t i = 0; i < 2; i++)
+            {
+                attributeDescriptions[i * 2].binding = i;
+                attributeDescriptions[i * 2].location = i * 2;
+                attributeDescriptions[i * 2].format = VK_FORMAT_R32G32_SFLOAT;
+                attributeDescriptions[i * 2].offset = offsetof(Particle, position);
+
+                attributeDescriptions[i * 2 + 1].binding = i;
+                attributeDescriptions[i * 2 + 1].location = i * 2 + 1;
+                attributeDescriptions[i * 2 + 1].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+                attributeDescriptions[i * 2 + 1].offset = offsetof(Particle, color);
+            }
 
         return attributeDescriptions;
     }
@@ -1,5 +1,7 @@
 #include "compute_pipeline.h"
+#include "pipeline_descriptions.h"
 #include "../genesis.h"
+#include "../../../components/shaders/shader_reflect.h"
 
 ComputePipeline::ComputePipeline() 
     {
@@ -19,8 +21,15 @@ void ComputePipeline::clear()
 
         instance = VK_NULL_HANDLE;
         layout = VK_NULL_HANDLE;
+        key = 0;
+        _shader_blob = nullptr;
         _shader_modules.clear();
         _shader_stages.clear();
+        _push_constant_range = {};
+        _create_flags = 0;
+        _workgroup_size = 0;
+        _specialization_entry = {};
+        _specialization_info = {};
 
         return;
     }
@@ -43,18 +52,69 @@ void ComputePipeline::addShaderStage(VkShaderModule shader_module, VkShaderStage
     }
 
 // TODO: build this into a createShader() function in the Core Pipeline Class for inheritance
-ComputePipeline& ComputePipeline::shaders(VkDevice* logical_device) 
+// The module is only built in create(), so a registry hit never touches the SPIR-V
+ComputePipeline& ComputePipeline::shaders(const ShaderBlob& comp) 
     {
         report(LOGGER::INFO, "ComputePipeline - Loading Shaders ..");
 
-        std::vector<char> _comp_shader = genesis::loadFile(comp_shader);
-        VkShaderModule _comp_shader_module;
-        genesis::createShaderModule(logical_device, _comp_shader, &_comp_shader_module);
-        addShaderStage(_comp_shader_module, VK_SHADER_STAGE_COMPUTE_BIT);
+        _shader_blob = &comp;
+
+        return *this;
+    }
+
+// One block per pipeline at offset 0. Call after shaders() so the size can be checked against the
+// block the shader declares, and before createLayout().
+ComputePipeline& ComputePipeline::pushConstants(VkShaderStageFlags stages, uint32_t size) 
+    {
+        report(LOGGER::INFO, "ComputePipeline - Adding Push Constant Block of %u bytes ..", size);
+
+        uint32_t _declared = _shader_blob ? reflectPushConstantSize(*_shader_blob) : 0;
+
+        if (_declared != size)
+            {
+                report(LOGGER::ERROR, "ComputePipeline - %s declares a %u byte push constant block, host struct is %u bytes ..", 
+                        _shader_blob ? _shader_blob->file : "(no shader)", _declared, size);
+                abort();
+            }
+
+        _push_constant_range = { .stageFlags = stages, .offset = 0, .size = size };
+
+        return *this;
+    }
+
+// Descriptor buffer layouts only work with pipelines created to read from descriptor buffers
+ComputePipeline& ComputePipeline::flags(VkPipelineCreateFlags create_flags) 
+    {
+        report(LOGGER::INFO, "ComputePipeline - Setting Create Flags ..");
+
+        _create_flags = create_flags;
 
         return *this;
     }
 
+// Specializes local_size_x_id = 0, the shader has no usable workgroup size without it
+ComputePipeline& ComputePipeline::workgroupSize(uint32_t workgroup_size) 
+    {
+        report(LOGGER::INFO, "ComputePipeline - Setting Workgroup Size to %u ..", workgroup_size);
+
+        _workgroup_size = workgroup_size;
+        _specialization_entry = { .constantID = 0, .offset = 0, .size = sizeof(uint32_t) };
+        _specialization_info = {
+                .mapEntryCount = 1,
+                .pMapEntries = &_specialization_entry,
+                .dataSize = sizeof(uint32_t),
+                .pData = &_workgroup_size
+            };
+
+        return *this;
+    }
+
+void ComputePipeline::_pushMismatch(size_t size)
+    {
+        report(LOGGER::ERROR, "ComputePipeline - Pushing %u bytes into a %u byte block ..", (uint32_t)size, _push_constant_range.size);
+        abort();
+    }
+
 ComputePipeline& ComputePipeline::createLayout(VkDevice* logical_device, VkDescriptorSetLayout* descriptor_layout) 
     {
         report(LOGGER::INFO, "ComputePipeline - Creating Layout ..");
@@ -63,9 +123,12 @@ ComputePipeline& ComputePipeline::createLayout(VkDevice* logical_device, VkDescr
                 .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
                 .setLayoutCount = 1,
                 .pSetLayouts = descriptor_layout,
+                .pushConstantRangeCount = _push_constant_range.size ? 1u : 0u,
+                .pPushConstantRanges = _push_constant_range.size ? &_push_constant_range : nullptr
         };
 
-        VK_TRY(vkCreatePipelineLayout(*logical_device, &_pipeline_layout_info, nullptr, &layout));
+        VK_TRY(vkCreatePipelineLayout(*logical_device, &_pipeline_layout_info, HOST_ALLOCATOR, &layout));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_PIPELINE_LAYOUT, layout, 0);
 
         return *this;
     }
@@ -74,15 +137,36 @@ ComputePipeline& ComputePipeline::create(VkDevice* logical_device)
     {
         report(LOGGER::INFO, "ComputePipeline - Creating Compute Pipeline ..");
 
+        VkShaderModule _comp_shader_module;
+        genesis::createShaderModule(logical_device, *_shader_blob, &_comp_shader_module);
+        addShaderStage(_comp_shader_module, VK_SHADER_STAGE_COMPUTE_BIT);
+        if (_workgroup_size) { _shader_stages[0].pSpecializationInfo = &_specialization_info; }
+
         VkComputePipelineCreateInfo _pipeline_info = {
                 .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+                .flags = _create_flags,
                 .stage = _shader_stages[0],
                 .layout = layout
             };
 
-        VK_TRY(vkCreateComputePipelines(*logical_device, VK_NULL_HANDLE, 1, &_pipeline_info, nullptr, &instance));
+        VK_TRY(vkCreateComputePipelines(*logical_device, VK_NULL_HANDLE, 1, &_pipeline_info, HOST_ALLOCATOR, &instance));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_PIPELINE, instance, 0);
 
-        vkDestroyShaderModule(*logical_device, _shader_stages[0].module, nullptr);
+        RELEASE_OBJECT(VK_OBJECT_TYPE_SHADER_MODULE, _shader_stages[0].module);
+        vkDestroyShaderModule(*logical_device, _shader_stages[0].module, HOST_ALLOCATOR);
 
         return *this;
     }
+
+// Everything that makes two compute pipelines interchangeable: the shader, its specialization, create flags and the layout description
+uint64_t ComputePipeline::hash()
+    {
+        uint64_t _hash = hashBytes(&_shader_blob->hash, sizeof(_shader_blob->hash));
+        _hash = hashBytes(&_workgroup_size, sizeof(_workgroup_size), _hash);
+        _hash = hashBytes(&_create_flags, sizeof(_create_flags), _hash);
+        _hash = PipelineDescriptions::get().hashSetLayouts(_pipeline_layout_info.pSetLayouts, _pipeline_layout_info.setLayoutCount, _hash);
+        _hash = hashBytes(&_pipeline_layout_info.pushConstantRangeCount, sizeof(uint32_t), _hash);
+        _hash = hashBytes(_pipeline_layout_info.pPushConstantRanges, sizeof(VkPushConstantRange) * _pipeline_layout_info.pushConstantRangeCount, _hash);
+
+        return _hash;
+    }
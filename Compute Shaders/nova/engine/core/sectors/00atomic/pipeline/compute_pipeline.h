@@ -1,24 +1,57 @@
 #pragma once
 #include "../atomic.h"
+#include "../../../components/shaders/shader_blob.h"
+
+#include <type_traits>
 
 class ComputePipeline {
     public:
         VkPipeline instance;
         VkPipelineLayout layout;
+        uint64_t key;                           // state hash the registry filed this pipeline under
 
         ComputePipeline();
         ~ComputePipeline();
 
-        ComputePipeline& shaders(VkDevice*);
+        ComputePipeline& shaders(const ShaderBlob&);
+        ComputePipeline& pushConstants(VkShaderStageFlags, uint32_t);
+        ComputePipeline& flags(VkPipelineCreateFlags);
+        ComputePipeline& workgroupSize(uint32_t);
+        uint64_t hash();
+
+        // Declares T as the pipeline's push constant block, checked against the shader when it's declared
+        template <typename T>
+        ComputePipeline& pushConstants(VkShaderStageFlags stages = VK_SHADER_STAGE_COMPUTE_BIT)
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "Push constants are copied byte for byte");
+                static_assert(sizeof(T) % 4 == 0, "Push constant ranges are sized in multiples of 4 bytes");
+                static_assert(sizeof(T) <= MAX_PUSH_CONSTANT_SIZE, "Push constant block is larger than every device guarantees");
+                return pushConstants(stages, sizeof(T));
+            }
+
+        template <typename T>
+        void push(VkCommandBuffer command_buffer, const T& constants)
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "Push constants are copied byte for byte");
+                if (sizeof(T) != _push_constant_range.size) { _pushMismatch(sizeof(T)); }
+                vkCmdPushConstants(command_buffer, layout, _push_constant_range.stageFlags, 0, sizeof(T), &constants);
+            }
         ComputePipeline& createLayout(VkDevice*, VkDescriptorSetLayout*);
         ComputePipeline& create(VkDevice*);
 
     private:
         std::vector<VkShaderModule> _shader_modules;
         std::vector<VkPipelineShaderStageCreateInfo> _shader_stages;
+        const ShaderBlob* _shader_blob;
         VkPipelineLayoutCreateInfo _pipeline_layout_info;
+        VkPushConstantRange _push_constant_range;
+        VkPipelineCreateFlags _create_flags;
+        uint32_t _workgroup_size;               // specialization constant 0, the shader's local_size_x
+        VkSpecializationMapEntry _specialization_entry;
+        VkSpecializationInfo _specialization_info;
 
         void clear();
         void addShaderStage(VkShaderModule, VkShaderStageFlagBits);
+        void _pushMismatch(size_t);
 
 };
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "graphics_pipeline.h"
+#include "pipeline_descriptions.h"
 #include "../genesis.h"
+#include "../../../components/shaders/shader_reflect.h"
 
 
     ////////////////////////
@@ -25,6 +27,7 @@ void GraphicsPipeline::clear()
     {
         report(LOGGER::VLINE, "\t\t .. Clearing Pipeline ..");
         instance = VK_NULL_HANDLE;
+        key = 0;
         _vertex_input_state = { .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO };
         _input_assembly = { .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO };
         _viewport_state = { .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO };
@@ -35,11 +38,15 @@ void GraphicsPipeline::clear()
         _pipeline_info = { .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO };
         _dynamic_state = { .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO };
         _pipeline_layout_info = { .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+        _push_constant_range = {};
         layout = {};
         _depth_stencil = { .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO }; // not used
         _render_info = { .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO };
+        _color_format = VK_FORMAT_UNDEFINED;
         _shader_stages.clear();
         _shader_modules.clear();
+        _shader_blobs.clear();
+        _dynamic_states = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
         vertices.clear();
         indices.clear();
     }
@@ -67,21 +74,13 @@ void GraphicsPipeline::addShaderStage(VkShaderModule shader_module, VkShaderStag
         return;
     }
 
-// TODO: extrapolate the shaders to be passed in as a parameter, and
-//       create a function that will dynamically create/update new shader modules
-GraphicsPipeline& GraphicsPipeline::shaders(VkDevice* logical_device)
+// The modules are only built in create(), so a registry hit never touches the SPIR-V
+GraphicsPipeline& GraphicsPipeline::shaders(const ShaderBlob& vert, const ShaderBlob& frag)
     {
         report(LOGGER::VLINE, "\t\t .. Creating Shaders ..");
 
-        std::vector<char> _vert_shader_code = genesis::loadFile(vert_shader);
-        VkShaderModule _vert_shader_module;
-        genesis::createShaderModule(logical_device, _vert_shader_code, &_vert_shader_module);
-        addShaderStage(_vert_shader_module, VK_SHADER_STAGE_VERTEX_BIT);
-
-        std::vector<char> _frag_shader_code = genesis::loadFile(frag_shader);
-        VkShaderModule _frag_shader_module;
-        genesis::createShaderModule(logical_device, _frag_shader_code, &_frag_shader_module);
-        addShaderStage(_frag_shader_module, VK_SHADER_STAGE_FRAGMENT_BIT);
+        _shader_blobs.push_back({ &vert, VK_SHADER_STAGE_VERTEX_BIT });
+        _shader_blobs.push_back({ &frag, VK_SHADER_STAGE_FRAGMENT_BIT });
 
         return *this;
     }
@@ -98,13 +97,22 @@ GraphicsPipeline& GraphicsPipeline::vertexInput()
         // Determine how to do this dynamically :thinking:
         // _binding_description = Vertex::getBindingDescription();
         // _attribute_descriptions = Vertex::getAttributeDescriptions();
-        _binding_description = Particle::getBindingDescription();
-        _attribute_descriptions = Particle::getAttributeDescriptions();
+        auto _particle_bindings = Particle::getBindingDescriptions();
+        auto _particle_attributes = Particle::getAttributeDescriptions();
+
+        return vertexInput({ _particle_bindings.begin(), _particle_bindings.end() }, { _particle_attributes.begin(), _particle_attributes.end() });
+    }
+
+// Bindings either per vertex or per instance, described by the caller
+GraphicsPipeline& GraphicsPipeline::vertexInput(const std::vector<VkVertexInputBindingDescription>& bindings, const std::vector<VkVertexInputAttributeDescription>& attributes)
+    {
+        _binding_descriptions = bindings;
+        _attribute_descriptions = attributes;
 
         _vertex_input_state = {
                 .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
-                .vertexBindingDescriptionCount = 1,
-                .pVertexBindingDescriptions = &_binding_description,
+                .vertexBindingDescriptionCount = static_cast<uint32_t>(_binding_descriptions.size()),
+                .pVertexBindingDescriptions = _binding_descriptions.data(),
                 .vertexAttributeDescriptionCount = static_cast<uint32_t>(_attribute_descriptions.size()),
                 .pVertexAttributeDescriptions = _attribute_descriptions.data()
             };
@@ -117,13 +125,13 @@ GraphicsPipeline& GraphicsPipeline::vertexInput()
     // INPUT ASSEMBLY //
     ////////////////////
 
-GraphicsPipeline& GraphicsPipeline::inputAssembly()
+GraphicsPipeline& GraphicsPipeline::inputAssembly(VkPrimitiveTopology topology)
     {
         report(LOGGER::VLINE, "\t\t .. Creating Input Assembly ..");
 
         _input_assembly = {
                 .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
-                .topology = VK_PRIMITIVE_TOPOLOGY_POINT_LIST, // TRIANGLE_LIST for meshes
+                .topology = topology,
                 .primitiveRestartEnable = VK_FALSE
             };
 
@@ -153,7 +161,7 @@ GraphicsPipeline& GraphicsPipeline::viewportState()
     // RASTERIZER //
     ////////////////
 
-GraphicsPipeline& GraphicsPipeline::rasterizer()
+GraphicsPipeline& GraphicsPipeline::rasterizer(VkCullModeFlags cull_mode)
     {
         report(LOGGER::VLINE, "\t\t .. Creating Rasterizer ..");
 
@@ -164,7 +172,7 @@ GraphicsPipeline& GraphicsPipeline::rasterizer()
                 .depthClampEnable = VK_FALSE,
                 .rasterizerDiscardEnable = VK_FALSE,
                 .polygonMode = VK_POLYGON_MODE_FILL,
-                .cullMode = VK_CULL_MODE_BACK_BIT,
+                .cullMode = cull_mode,
                 .frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE,
                 .depthBiasEnable = VK_FALSE,
                 .depthBiasConstantFactor = 0.0f,
@@ -269,10 +277,41 @@ GraphicsPipeline& GraphicsPipeline::colorBlending()
     // DYNAMIC STATE //
     ///////////////////
 
-GraphicsPipeline& GraphicsPipeline::dynamicState()
+// Each extended dynamic state level moves more of the fixed function state into the command buffer.
+// The values baked in above are still required, they just become the defaults the render path overrides.
+GraphicsPipeline& GraphicsPipeline::dynamicState(uint32_t extended_level)
     {
         report(LOGGER::VLINE, "\t\t .. Creating Dynamic State ..");
 
+        if (extended_level >= 1)
+            {
+                report(LOGGER::VLINE, "\t\t\t .. Adding Extended Dynamic State ..");
+                _dynamic_states.insert(_dynamic_states.end(), {
+                        VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY,
+                        VK_DYNAMIC_STATE_CULL_MODE,
+                        VK_DYNAMIC_STATE_FRONT_FACE,
+                        VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE,
+                        VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE,
+                        VK_DYNAMIC_STATE_DEPTH_COMPARE_OP
+                    });
+            }
+
+        if (extended_level >= 2)
+            {
+                report(LOGGER::VLINE, "\t\t\t .. Adding Extended Dynamic State 2 ..");
+                _dynamic_states.push_back(VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE);
+            }
+
+        if (extended_level >= 3)
+            {
+                report(LOGGER::VLINE, "\t\t\t .. Adding Extended Dynamic State 3 ..");
+                _dynamic_states.insert(_dynamic_states.end(), {
+                        VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT,
+                        VK_DYNAMIC_STATE_COLOR_BLEND_EQUATION_EXT,
+                        VK_DYNAMIC_STATE_COLOR_WRITE_MASK_EXT
+                    });
+            }
+
         _dynamic_state = {
                 .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
                 .dynamicStateCount = static_cast<uint32_t>(_dynamic_states.size()),
@@ -283,6 +322,43 @@ GraphicsPipeline& GraphicsPipeline::dynamicState()
     }
 
 
+    ////////////////////
+    // PUSH CONSTANTS //
+    ////////////////////
+
+// One block per pipeline at offset 0, shared by every stage in stages. Call after shaders() so the size
+// can be checked against the largest block those stages declare, and before createLayout().
+GraphicsPipeline& GraphicsPipeline::pushConstants(VkShaderStageFlags stages, uint32_t size)
+    {
+        report(LOGGER::VLINE, "\t\t .. Adding Push Constant Block of %u bytes ..", size);
+
+        uint32_t _declared = 0;
+        for (auto& [_blob, _stage] : _shader_blobs)
+            {
+                if (!(_stage & stages)) { continue; }
+
+                uint32_t _size = reflectPushConstantSize(*_blob);
+                if (_size > _declared) { _declared = _size; }
+            }
+
+        if (_declared != size)
+            {
+                report(LOGGER::ERROR, "GraphicsPipeline - Shaders declare a %u byte push constant block, host struct is %u bytes ..", _declared, size);
+                abort();
+            }
+
+        _push_constant_range = { .stageFlags = stages, .offset = 0, .size = size };
+
+        return *this;
+    }
+
+void GraphicsPipeline::_pushMismatch(size_t size)
+    {
+        report(LOGGER::ERROR, "GraphicsPipeline - Pushing %u bytes into a %u byte block ..", (uint32_t)size, _push_constant_range.size);
+        abort();
+    }
+
+
     ////////////
     // LAYOUT //
     ////////////
@@ -305,9 +381,12 @@ GraphicsPipeline& GraphicsPipeline::createLayout(VkDevice* logical_device, VkDes
                 .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
                 .setLayoutCount = 0,
                 .pSetLayouts = nullptr,
+                .pushConstantRangeCount = _push_constant_range.size ? 1u : 0u,
+                .pPushConstantRanges = _push_constant_range.size ? &_push_constant_range : nullptr
             };
 
-        VK_TRY(vkCreatePipelineLayout(*logical_device, &_pipeline_layout_info, nullptr, &layout));
+        VK_TRY(vkCreatePipelineLayout(*logical_device, &_pipeline_layout_info, HOST_ALLOCATOR, &layout));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_PIPELINE_LAYOUT, layout, 0);
         report(LOGGER::VLINE, "\t\t .. Pipeline Layout Created ..");
         return *this;
     }
@@ -318,8 +397,8 @@ GraphicsPipeline& GraphicsPipeline::pipe(VkRenderPass* render_pass)
 
         _pipeline_info = {
                 .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-                .stageCount = 2,
-                .pStages = _shader_stages.data(),
+                .stageCount = static_cast<uint32_t>(_shader_blobs.size()),
+                .pStages = nullptr,                 // filled in by create() once the modules exist
                 .pVertexInputState = &_vertex_input_state,
                 .pInputAssemblyState = &_input_assembly,
                 .pViewportState = &_viewport_state,
@@ -337,15 +416,125 @@ GraphicsPipeline& GraphicsPipeline::pipe(VkRenderPass* render_pass)
         return *this;
     }
 
+// Dynamic rendering has no render pass, the pipeline only needs the formats it will render into
+GraphicsPipeline& GraphicsPipeline::pipe(VkFormat color_format)
+    {
+        report(LOGGER::VLINE, "\t\t .. Creating Dynamic Rendering Info ..");
+
+        _color_format = color_format;
+        _render_info = {
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+                .pNext = nullptr,
+                .viewMask = 0,
+                .colorAttachmentCount = 1,
+                .pColorAttachmentFormats = &_color_format,
+                .depthAttachmentFormat = VK_FORMAT_UNDEFINED,
+                .stencilAttachmentFormat = VK_FORMAT_UNDEFINED
+            };
+
+        VkRenderPass _no_render_pass = VK_NULL_HANDLE;
+        pipe(&_no_render_pass);
+        _pipeline_info.pNext = &_render_info;
+
+        return *this;
+    }
+
 GraphicsPipeline& GraphicsPipeline::create(VkDevice* logical_device)
     {
         report(LOGGER::VLINE, "\t\t .. Constructing Pipeline ..");
-        VK_TRY(vkCreateGraphicsPipelines(*logical_device, VK_NULL_HANDLE, 1, &_pipeline_info, nullptr, &instance));
+
+        for (auto& [_blob, _stage] : _shader_blobs)
+            {
+                VkShaderModule _shader_module;
+                genesis::createShaderModule(logical_device, *_blob, &_shader_module);
+                addShaderStage(_shader_module, _stage);
+            }
+
+        _pipeline_info.stageCount = static_cast<uint32_t>(_shader_stages.size());
+        _pipeline_info.pStages = _shader_stages.data();
+
+        VK_TRY(vkCreateGraphicsPipelines(*logical_device, VK_NULL_HANDLE, 1, &_pipeline_info, HOST_ALLOCATOR, &instance));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_PIPELINE, instance, 0);
 
         report(LOGGER::VLINE, "\t\t .. Cleaning Up Shader Modules ..");
         for (auto shader_module : _shader_modules) 
-            { vkDestroyShaderModule(*logical_device, shader_module, nullptr); }
+            {
+                RELEASE_OBJECT(VK_OBJECT_TYPE_SHADER_MODULE, shader_module);
+                vkDestroyShaderModule(*logical_device, shader_module, HOST_ALLOCATOR);
+            }
+
+        _shader_modules.clear();
+        _shader_stages.clear();
 
         return *this;
     }
 
+
+    ////////////////
+    // STATE HASH //
+    ////////////////
+
+template <typename T>
+static inline uint64_t _hashValue(uint64_t hash, const T& value) { return hashBytes(&value, sizeof(T), hash); }
+
+// Hashes every piece of builder state that changes the compiled pipeline, field by field so that
+// pNext pointers and struct padding never leak into the key. Call this after pipe().
+uint64_t GraphicsPipeline::hash()
+    {
+        uint64_t _hash = FNV_OFFSET_BASIS;
+
+        for (auto& [_blob, _stage] : _shader_blobs)
+            {
+                _hash = _hashValue(_hash, _blob->hash);
+                _hash = _hashValue(_hash, _stage);
+            }
+
+        for (const auto& _binding : _binding_descriptions)
+            { _hash = _hashValue(_hash, _binding); }
+        for (const auto& _attribute : _attribute_descriptions)
+            { _hash = _hashValue(_hash, _attribute); }
+
+        _hash = _hashValue(_hash, _input_assembly.topology);
+        _hash = _hashValue(_hash, _input_assembly.primitiveRestartEnable);
+
+        _hash = _hashValue(_hash, _viewport_state.viewportCount);
+        _hash = _hashValue(_hash, _viewport_state.scissorCount);
+
+        _hash = _hashValue(_hash, _rasterizer.depthClampEnable);
+        _hash = _hashValue(_hash, _rasterizer.rasterizerDiscardEnable);
+        _hash = _hashValue(_hash, _rasterizer.polygonMode);
+        _hash = _hashValue(_hash, _rasterizer.cullMode);
+        _hash = _hashValue(_hash, _rasterizer.frontFace);
+        _hash = _hashValue(_hash, _rasterizer.depthBiasEnable);
+        _hash = _hashValue(_hash, _rasterizer.lineWidth);
+
+        _hash = _hashValue(_hash, _multisampling.rasterizationSamples);
+        _hash = _hashValue(_hash, _multisampling.sampleShadingEnable);
+
+        if (_pipeline_info.pDepthStencilState != nullptr)
+            {
+                _hash = _hashValue(_hash, _depth_stencil.depthTestEnable);
+                _hash = _hashValue(_hash, _depth_stencil.depthWriteEnable);
+                _hash = _hashValue(_hash, _depth_stencil.depthCompareOp);
+            }
+
+        _hash = _hashValue(_hash, _color_blend_attachment);
+        _hash = _hashValue(_hash, _color_blending.logicOpEnable);
+        _hash = _hashValue(_hash, _color_blending.logicOp);
+        _hash = _hashValue(_hash, _color_blending.blendConstants);
+
+        for (const auto& _state : _dynamic_states)
+            { _hash = _hashValue(_hash, _state); }
+
+        // Layouts with the same description are compatible, so hash the description rather than the handle
+        _hash = PipelineDescriptions::get().hashSetLayouts(_pipeline_layout_info.pSetLayouts, _pipeline_layout_info.setLayoutCount, _hash);
+        _hash = hashBytes(_pipeline_layout_info.pPushConstantRanges, sizeof(VkPushConstantRange) * _pipeline_layout_info.pushConstantRangeCount, _hash);
+
+        // Render pass compatibility, or just the attachment formats under dynamic rendering
+        _hash = PipelineDescriptions::get().hashRenderPass(_pipeline_info.renderPass, _hash);
+        _hash = _hashValue(_hash, _pipeline_info.subpass);
+        _hash = _hashValue(_hash, _color_format);
+
+        return _hash;
+    }
+
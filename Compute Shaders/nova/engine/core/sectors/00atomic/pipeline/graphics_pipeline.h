@@ -1,8 +1,10 @@
 #pragma once
 #include "../atomic.h"
 #include "../vertex.h"
+#include "../../../components/shaders/shader_blob.h"
 
 #include <vector>
+#include <type_traits>
 
 /*
     The Pipeline class is a builder that allows for the creation of a graphics pipeline
@@ -18,34 +20,60 @@ class GraphicsPipeline {
 
         VkPipeline instance;
         VkPipelineLayout layout;
+        uint64_t key;                           // state hash the registry filed this pipeline under
         std::vector<Vertex> vertices = {};
         std::vector<uint32_t> indices = {};
 
-        GraphicsPipeline& shaders(VkDevice*);
+        GraphicsPipeline& shaders(const ShaderBlob&, const ShaderBlob&);
         GraphicsPipeline& vertexInput();
-        GraphicsPipeline& inputAssembly();
+        GraphicsPipeline& vertexInput(const std::vector<VkVertexInputBindingDescription>&, const std::vector<VkVertexInputAttributeDescription>&);
+        GraphicsPipeline& inputAssembly(VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_POINT_LIST);
         GraphicsPipeline& viewportState();
-        GraphicsPipeline& rasterizer();
+        GraphicsPipeline& rasterizer(VkCullModeFlags cull_mode = VK_CULL_MODE_BACK_BIT);
         GraphicsPipeline& multisampling(VkSampleCountFlagBits);
         GraphicsPipeline& depthStencil();
         GraphicsPipeline& colorBlending();
-        GraphicsPipeline& dynamicState();
+        GraphicsPipeline& dynamicState(uint32_t extended_level = 0);
+        GraphicsPipeline& pushConstants(VkShaderStageFlags, uint32_t);
         GraphicsPipeline& createLayout(VkDevice*, VkDescriptorSetLayout*);
         GraphicsPipeline& pipe(VkRenderPass*);
+        GraphicsPipeline& pipe(VkFormat);
         GraphicsPipeline& create(VkDevice*);
+        uint64_t hash();
         void clear();
 
+        // Declares T as the pipeline's push constant block, checked against the shaders when it's declared
+        template <typename T>
+        GraphicsPipeline& pushConstants(VkShaderStageFlags stages = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT)
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "Push constants are copied byte for byte");
+                static_assert(sizeof(T) % 4 == 0, "Push constant ranges are sized in multiples of 4 bytes");
+                static_assert(sizeof(T) <= MAX_PUSH_CONSTANT_SIZE, "Push constant block is larger than every device guarantees");
+                return pushConstants(stages, sizeof(T));
+            }
+
+        template <typename T>
+        void push(VkCommandBuffer command_buffer, const T& constants)
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "Push constants are copied byte for byte");
+                if (sizeof(T) != _push_constant_range.size) { _pushMismatch(sizeof(T)); }
+                vkCmdPushConstants(command_buffer, layout, _push_constant_range.stageFlags, 0, sizeof(T), &constants);
+            }
+
 
     private:
         VkGraphicsPipelineCreateInfo _pipeline_info;
         VkPipelineLayoutCreateInfo _pipeline_layout_info;
+        VkPushConstantRange _push_constant_range;
         VkPipelineViewportStateCreateInfo _viewport_state;
         VkPipelineVertexInputStateCreateInfo _vertex_input_state;
         VkPipelineInputAssemblyStateCreateInfo _input_assembly;
         VkPipelineDynamicStateCreateInfo _dynamic_state;
         std::vector<VkShaderModule> _shader_modules;
         std::vector<VkPipelineShaderStageCreateInfo> _shader_stages;
-        VkRenderingInfo _render_info;
+        std::vector<std::pair<const ShaderBlob*, VkShaderStageFlagBits>> _shader_blobs;
+        VkPipelineRenderingCreateInfo _render_info;
+        VkFormat _color_format;
         VkPipelineRasterizationStateCreateInfo _rasterizer;
         VkPipelineMultisampleStateCreateInfo _multisampling;
         VkPipelineDepthStencilStateCreateInfo _depth_stencil;
@@ -53,8 +81,9 @@ class GraphicsPipeline {
         VkPipelineColorBlendStateCreateInfo _color_blending;
         std::vector<VkDynamicState> _dynamic_states = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
        
-        VkVertexInputBindingDescription _binding_description;
-        std::array<VkVertexInputAttributeDescription, 2U> _attribute_descriptions;
+        std::vector<VkVertexInputBindingDescription> _binding_descriptions;
+        std::vector<VkVertexInputAttributeDescription> _attribute_descriptions;
 
         void addShaderStage(VkShaderModule, VkShaderStageFlagBits);
+        void _pushMismatch(size_t);
 };
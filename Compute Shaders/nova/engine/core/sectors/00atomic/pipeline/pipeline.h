@@ -1,7 +1,5 @@
 #pragma once
 #include "graphics_pipeline.h"
 #include "compute_pipeline.h"
-
-#include <variant>
-
-//typedef std::variant<GraphicsPipeline, ComputePipeline> Pipeline; // Pipeline variant
\ No newline at end of file
+#include "pipeline_registry.h"
+#include "pipeline_descriptions.h"
@@ -0,0 +1,125 @@
+#include "pipeline_descriptions.h"
+#include "../../../components/utility/hash.h"
+
+template <typename T>
+static inline uint64_t _hashValue(uint64_t hash, const T& value) { return hashBytes(&value, sizeof(T), hash); }
+
+static inline uint64_t _hashReference(uint64_t hash, const VkAttachmentReference* reference)
+    { return _hashValue(hash, reference == nullptr ? VK_ATTACHMENT_UNUSED : reference->attachment); }
+
+PipelineDescriptions& PipelineDescriptions::get()
+    {
+        static PipelineDescriptions _descriptions;
+        return _descriptions;
+    }
+
+
+    //////////////
+    // DESCRIBE //
+    //////////////
+
+// The bindings and their flags, including the per-binding flags a bindless layout chains on
+void PipelineDescriptions::describeSetLayout(VkDescriptorSetLayout layout, const VkDescriptorSetLayoutCreateInfo& info)
+    {
+        uint64_t _hash = _hashValue(FNV_OFFSET_BASIS, info.flags);
+
+        for (uint32_t i = 0; i < info.bindingCount; i++)
+            {
+                const VkDescriptorSetLayoutBinding& _binding = info.pBindings[i];
+                _hash = _hashValue(_hash, _binding.binding);
+                _hash = _hashValue(_hash, _binding.descriptorType);
+                _hash = _hashValue(_hash, _binding.descriptorCount);
+                _hash = _hashValue(_hash, _binding.stageFlags);
+                _hash = _hashValue(_hash, _binding.pImmutableSamplers != nullptr);
+            }
+
+        for (const VkBaseInStructure* _next = (const VkBaseInStructure*)info.pNext; _next != nullptr; _next = _next->pNext)
+            {
+                if (_next->sType != VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO) { continue; }
+
+                const VkDescriptorSetLayoutBindingFlagsCreateInfo* _flags = (const VkDescriptorSetLayoutBindingFlagsCreateInfo*)_next;
+                _hash = hashBytes(_flags->pBindingFlags, sizeof(VkDescriptorBindingFlags) * _flags->bindingCount, _hash);
+            }
+
+        std::lock_guard<std::mutex> _lock(_mutex);
+        _set_layouts[(uint64_t)layout] = _hash;
+
+        return;
+    }
+
+// Render pass compatibility only looks at attachment formats and sample counts and how the subpasses use them
+void PipelineDescriptions::describeRenderPass(VkRenderPass render_pass, const VkRenderPassCreateInfo& info)
+    {
+        uint64_t _hash = _hashValue(FNV_OFFSET_BASIS, info.attachmentCount);
+
+        for (uint32_t i = 0; i < info.attachmentCount; i++)
+            {
+                _hash = _hashValue(_hash, info.pAttachments[i].format);
+                _hash = _hashValue(_hash, info.pAttachments[i].samples);
+            }
+
+        _hash = _hashValue(_hash, info.subpassCount);
+
+        for (uint32_t i = 0; i < info.subpassCount; i++)
+            {
+                const VkSubpassDescription& _subpass = info.pSubpasses[i];
+                _hash = _hashValue(_hash, _subpass.colorAttachmentCount);
+
+                for (uint32_t c = 0; c < _subpass.colorAttachmentCount; c++)
+                    {
+                        _hash = _hashReference(_hash, &_subpass.pColorAttachments[c]);
+                        _hash = _hashReference(_hash, _subpass.pResolveAttachments ? &_subpass.pResolveAttachments[c] : nullptr);
+                    }
+
+                _hash = _hashReference(_hash, _subpass.pDepthStencilAttachment);
+            }
+
+        std::lock_guard<std::mutex> _lock(_mutex);
+        _render_passes[(uint64_t)render_pass] = _hash;
+
+        return;
+    }
+
+void PipelineDescriptions::forgetSetLayout(VkDescriptorSetLayout layout)
+    {
+        std::lock_guard<std::mutex> _lock(_mutex);
+        _set_layouts.erase((uint64_t)layout);
+
+        return;
+    }
+
+void PipelineDescriptions::forgetRenderPass(VkRenderPass render_pass)
+    {
+        std::lock_guard<std::mutex> _lock(_mutex);
+        _render_passes.erase((uint64_t)render_pass);
+
+        return;
+    }
+
+
+    //////////
+    // HASH //
+    //////////
+
+uint64_t PipelineDescriptions::hashSetLayouts(const VkDescriptorSetLayout* layouts, uint32_t count, uint64_t hash)
+    {
+        std::lock_guard<std::mutex> _lock(_mutex);
+
+        hash = _hashValue(hash, count);
+        for (uint32_t i = 0; i < count; i++)
+            {
+                auto _description = _set_layouts.find((uint64_t)layouts[i]);
+                hash = _hashValue(hash, _description != _set_layouts.end() ? _description->second : (uint64_t)layouts[i]);
+            }
+
+        return hash;
+    }
+
+// VK_NULL_HANDLE under dynamic rendering, where the builder hashes the attachment formats itself
+uint64_t PipelineDescriptions::hashRenderPass(VkRenderPass render_pass, uint64_t hash)
+    {
+        std::lock_guard<std::mutex> _lock(_mutex);
+
+        auto _description = _render_passes.find((uint64_t)render_pass);
+        return _hashValue(hash, _description != _render_passes.end() ? _description->second : (uint64_t)render_pass);
+    }
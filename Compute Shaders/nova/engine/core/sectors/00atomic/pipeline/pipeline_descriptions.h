@@ -0,0 +1,34 @@
+#pragma once
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+/*
+    PipelineDescriptions remembers what each descriptor set layout and render pass was created
+    from, as a digest, so the pipeline builders can key on compatibility instead of on handles.
+    Two layouts built from the same bindings, or two render passes with the same attachments,
+    hash the same, and a handle the driver recycles for something different hashes differently.
+    Describe a handle right after creating it and forget it right before destroying it. A handle
+    that was never described falls back to its value.
+*/
+
+class PipelineDescriptions {
+    public:
+        static PipelineDescriptions& get();
+
+        void describeSetLayout(VkDescriptorSetLayout, const VkDescriptorSetLayoutCreateInfo&);
+        void describeRenderPass(VkRenderPass, const VkRenderPassCreateInfo&);
+        void forgetSetLayout(VkDescriptorSetLayout);
+        void forgetRenderPass(VkRenderPass);
+        uint64_t hashSetLayouts(const VkDescriptorSetLayout*, uint32_t, uint64_t);
+        uint64_t hashRenderPass(VkRenderPass, uint64_t);
+
+    private:
+        std::mutex _mutex;
+        std::unordered_map<uint64_t, uint64_t> _set_layouts;    // handle to description digest
+        std::unordered_map<uint64_t, uint64_t> _render_passes;
+
+        PipelineDescriptions() {}
+};
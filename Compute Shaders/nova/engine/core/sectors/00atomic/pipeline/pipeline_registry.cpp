@@ -0,0 +1,98 @@
+#include "pipeline_registry.h"
+
+PipelineRegistry::PipelineRegistry()
+    {
+        report(LOGGER::INFO, "PipelineRegistry - Instantiating ..");
+        _hits = 0;
+        _misses = 0;
+    }
+
+PipelineRegistry::~PipelineRegistry()
+    {
+        report(LOGGER::INFO, "PipelineRegistry - Destroying ..");
+
+        if (!_entries.empty())
+            { report(LOGGER::ERROR, "PipelineRegistry - %zu pipelines were never released ..", _entries.size()); }
+    }
+
+
+    /////////////////////
+    // ACQUIRE/RELEASE //
+    /////////////////////
+
+// Returns the pipeline for the builder's current state, compiling it only on a miss.
+// The lock is held through the compile so two threads asking for the same variant compile it once.
+VkPipeline PipelineRegistry::acquire(VkDevice* logical_device, Pipeline pipeline)
+    {
+        std::lock_guard<std::mutex> _guard(_lock);
+
+        return std::visit([&](auto* builder) -> VkPipeline {
+                builder->key = builder->hash();
+                auto _entry = _entries.find(builder->key);
+
+                if (_entry != _entries.end())
+                    {
+                        report(LOGGER::VLINE, "\t .. Pipeline Registry Hit %016llx ..", (unsigned long long)builder->key);
+                        _hits++;
+                        _entry->second.references++;
+                        builder->instance = _entry->second.pipeline;
+                        return builder->instance;
+                    }
+
+                report(LOGGER::VLINE, "\t .. Pipeline Registry Miss %016llx, Compiling ..", (unsigned long long)builder->key);
+                _misses++;
+                builder->create(logical_device);
+                _entries[builder->key] = { .pipeline = builder->instance, .references = 1 };
+
+                return builder->instance;
+            }, pipeline);
+    }
+
+void PipelineRegistry::release(VkDevice* logical_device, uint64_t key)
+    {
+        std::lock_guard<std::mutex> _guard(_lock);
+
+        auto _entry = _entries.find(key);
+
+        if (_entry == _entries.end())
+            { report(LOGGER::ERROR, "PipelineRegistry - Releasing unknown pipeline %016llx ..", (unsigned long long)key); return; }
+
+        if (--_entry->second.references == 0)
+            {
+                report(LOGGER::VLINE, "\t .. Destroying Pipeline %016llx ..", (unsigned long long)key);
+                RELEASE_OBJECT(VK_OBJECT_TYPE_PIPELINE, _entry->second.pipeline);
+                vkDestroyPipeline(*logical_device, _entry->second.pipeline, HOST_ALLOCATOR);
+                _entries.erase(_entry);
+            }
+
+        return;
+    }
+
+void PipelineRegistry::clear(VkDevice* logical_device)
+    {
+        std::lock_guard<std::mutex> _guard(_lock);
+
+        for (auto& [_key, _entry] : _entries)
+            {
+                RELEASE_OBJECT(VK_OBJECT_TYPE_PIPELINE, _entry.pipeline);
+                vkDestroyPipeline(*logical_device, _entry.pipeline, HOST_ALLOCATOR);
+            }
+
+        _entries.clear();
+
+        return;
+    }
+
+size_t PipelineRegistry::size()
+    {
+        std::lock_guard<std::mutex> _guard(_lock);
+        return _entries.size();
+    }
+
+void PipelineRegistry::log()
+    {
+        report(LOGGER::DEBUG, "\t .. Logging Pipeline Registry ..");
+        report(LOGGER::DLINE, "\t\tPipelines: %zu", size());
+        report(LOGGER::DLINE, "\t\tHits: %u", _hits);
+        report(LOGGER::DLINE, "\t\tMisses: %u", _misses);
+    }
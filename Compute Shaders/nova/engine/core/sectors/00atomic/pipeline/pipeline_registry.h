@@ -0,0 +1,39 @@
+#pragma once
+#include "graphics_pipeline.h"
+#include "compute_pipeline.h"
+
+#include <variant>
+#include <unordered_map>
+#include <mutex>
+
+typedef std::variant<GraphicsPipeline*, ComputePipeline*> Pipeline; // Pipeline variant
+
+/*
+    The PipelineRegistry hands out VkPipelines keyed by the complete builder state. A configured
+    builder that hashes to a pipeline we already compiled gets that pipeline back, anything else
+    is compiled on the spot. The registry owns the VkPipeline handles, the builders own their layouts.
+*/
+
+class PipelineRegistry {
+    public:
+        PipelineRegistry();
+        ~PipelineRegistry();
+
+        VkPipeline acquire(VkDevice*, Pipeline);
+        void release(VkDevice*, uint64_t);
+        void clear(VkDevice*);
+        size_t size();
+        void log();
+
+    private:
+        struct Entry 
+            {
+                VkPipeline pipeline;
+                uint32_t references;
+            };
+
+        std::unordered_map<uint64_t, Entry> _entries;
+        std::mutex _lock;
+        uint32_t _hits;
+        uint32_t _misses;
+};
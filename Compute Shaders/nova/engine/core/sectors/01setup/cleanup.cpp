@@ -4,28 +4,53 @@ NovaCore::~NovaCore()
     {
         report(LOGGER::INFO, "NovaCore - Destroying Context ..");
 
+        TraceRecorder::get().finish();
+        frame_stats.log(true);
+        if (config.bench_path != nullptr) { writeBenchmark(); }
+
+        destroyCaptureRing();
         destroySwapChain();
         queues.deletion.flush();
-        vkDestroyDescriptorPool(logical_device, descriptor.pool, nullptr);
-        vkDestroyDescriptorSetLayout(logical_device, descriptor.layout, nullptr);
+        descriptor_allocator.destroy(&logical_device);
+        RELEASE_OBJECT(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, descriptor.layout);
+        PipelineDescriptions::get().forgetSetLayout(descriptor.layout);
+        vkDestroyDescriptorSetLayout(logical_device, descriptor.layout, HOST_ALLOCATOR);
         destroyVertexContext();
         destroyIndexContext();
         destroyCommandContext();
         destroyPipeline(graphics_pipeline);
         destroyPipeline(compute_pipeline);
+        destroyHud();
+        pipelines.clear(&logical_device);
         destroyComputeResources();
 
+        gpu_profiler.log();
+        gpu_profiler.destroy();
+        pipeline_statistics.log();
+        pipeline_statistics.destroy();
+
         report(LOGGER::VLINE, "\t .. Destroying Pipeline and Render Pass.");
-        vkDestroyRenderPass(logical_device, render_pass, nullptr);
+        RELEASE_OBJECT(VK_OBJECT_TYPE_RENDER_PASS, render_pass);
+        PipelineDescriptions::get().forgetRenderPass(render_pass);
+        vkDestroyRenderPass(logical_device, render_pass, HOST_ALLOCATOR);
 
         report(LOGGER::VLINE, "\t .. Destroying Logical Device.");
-        vkDestroyDevice(logical_device, nullptr);
+        RELEASE_OBJECT(VK_OBJECT_TYPE_DEVICE, logical_device);
+        vkDestroyDevice(logical_device, HOST_ALLOCATOR);
 
-        report(LOGGER::VLINE, "\t .. Destroying Surface.");
-        vkDestroySurfaceKHR(instance, surface, nullptr);
+        // SDL made the surface without callbacks
+        if (surface != VK_NULL_HANDLE)
+            {
+                report(LOGGER::VLINE, "\t .. Destroying Surface.");
+                RELEASE_OBJECT(VK_OBJECT_TYPE_SURFACE_KHR, surface);
+                vkDestroySurfaceKHR(instance, surface, nullptr);
+            }
 
         report(LOGGER::VLINE, "\t .. Destroying Instance.");
-        vkDestroyInstance(instance, nullptr);
+        RELEASE_OBJECT(VK_OBJECT_TYPE_INSTANCE, instance);
+        vkDestroyInstance(instance, HOST_ALLOCATOR);
+        HostAllocator::get().log();
+        ObjectRegistry::get().logLeaks();
 
         _blankContext();
     }
@@ -34,18 +59,33 @@ void NovaCore::destroySwapChain()
     {
         report(LOGGER::VERBOSE, "Presentation - Destroying Swapchain ..");
 
+        destroyRetiredSwapChains(true);
+
         for (const auto& _frame_buffers : swapchain.framebuffers) 
-            { vkDestroyFramebuffer(logical_device, _frame_buffers, nullptr); }
+            {
+                RELEASE_OBJECT(VK_OBJECT_TYPE_FRAMEBUFFER, _frame_buffers);
+                vkDestroyFramebuffer(logical_device, _frame_buffers, HOST_ALLOCATOR);
+            }
         
         //swapchain.framebuffers.clear();
 
         
         for (const auto& _image_view : swapchain.image_views) 
-            { vkDestroyImageView(logical_device, _image_view, nullptr); }
+            {
+                RELEASE_OBJECT(VK_OBJECT_TYPE_IMAGE_VIEW, _image_view);
+                vkDestroyImageView(logical_device, _image_view, HOST_ALLOCATOR);
+            }
 
         //swapchain.image_views.clear();
 
-        vkDestroySwapchainKHR(logical_device, swapchain.instance, nullptr);
+        destroyRenderTargets(render_targets);
+
+        // Headless targets are plain images, the deletion queue frees them
+        if (swapchain.instance != VK_NULL_HANDLE)
+            {
+                RELEASE_OBJECT(VK_OBJECT_TYPE_SWAPCHAIN_KHR, swapchain.instance);
+                vkDestroySwapchainKHR(logical_device, swapchain.instance, HOST_ALLOCATOR);
+            }
 
         return;
     }
@@ -77,20 +117,26 @@ void NovaCore::destroyCommandContext()
         report(LOGGER::VERBOSE, "Management - Destroying Semaphores, Fences and Command Pools ..");
         for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) 
             {
-                vkDestroySemaphore(logical_device, frames[i].image_available, nullptr);
-                vkDestroySemaphore(logical_device, frames[i].render_finished, nullptr);
-                vkDestroyFence(logical_device, frames[i].in_flight, nullptr);
+                RELEASE_OBJECT(VK_OBJECT_TYPE_SEMAPHORE, frames[i].image_available);
+                vkDestroySemaphore(logical_device, frames[i].image_available, HOST_ALLOCATOR);
+                RELEASE_OBJECT(VK_OBJECT_TYPE_SEMAPHORE, frames[i].render_finished);
+                vkDestroySemaphore(logical_device, frames[i].render_finished, HOST_ALLOCATOR);
+                RELEASE_OBJECT(VK_OBJECT_TYPE_FENCE, frames[i].in_flight);
+                vkDestroyFence(logical_device, frames[i].in_flight, HOST_ALLOCATOR);
             }
 
-        vkDestroyCommandPool(logical_device, queues.command_pool, nullptr);
-        vkDestroyCommandPool(logical_device, queues.transfer.pool, nullptr);
+        RELEASE_OBJECT(VK_OBJECT_TYPE_COMMAND_POOL, queues.command_pool);
+        vkDestroyCommandPool(logical_device, queues.command_pool, HOST_ALLOCATOR);
+        RELEASE_OBJECT(VK_OBJECT_TYPE_COMMAND_POOL, queues.transfer.pool);
+        vkDestroyCommandPool(logical_device, queues.transfer.pool, HOST_ALLOCATOR);
     }
 
 void NovaCore::destroyPipeline(GraphicsPipeline* pipeline)
     {
         report(LOGGER::DEBUG, "Management - Destroying Pipeline.");
-        vkDestroyPipeline(logical_device, pipeline->instance, nullptr);
-        vkDestroyPipelineLayout(logical_device, pipeline->layout, nullptr);
+        pipelines.release(&logical_device, pipeline->key);
+        RELEASE_OBJECT(VK_OBJECT_TYPE_PIPELINE_LAYOUT, pipeline->layout);
+        vkDestroyPipelineLayout(logical_device, pipeline->layout, HOST_ALLOCATOR);
         delete pipeline;
         return;
     }
@@ -98,8 +144,9 @@ void NovaCore::destroyPipeline(GraphicsPipeline* pipeline)
 void NovaCore::destroyPipeline(ComputePipeline* pipeline)
     {
         report(LOGGER::DEBUG, "Management - Destroying Pipeline.");
-        vkDestroyPipeline(logical_device, pipeline->instance, nullptr);
-        vkDestroyPipelineLayout(logical_device, pipeline->layout, nullptr);
+        pipelines.release(&logical_device, pipeline->key);
+        RELEASE_OBJECT(VK_OBJECT_TYPE_PIPELINE_LAYOUT, pipeline->layout);
+        vkDestroyPipelineLayout(logical_device, pipeline->layout, HOST_ALLOCATOR);
         delete pipeline;
         return;
     }
@@ -109,13 +156,15 @@ void NovaCore::destroyBuffer(BufferContext* buffer)
         if (buffer->buffer != VK_NULL_HANDLE) 
             { 
                 report(LOGGER::VERBOSE, "Management - Destroying Buffer ..");
-                vkDestroyBuffer(logical_device, buffer->buffer, nullptr);
+                RELEASE_OBJECT(VK_OBJECT_TYPE_BUFFER, buffer->buffer);
+                vkDestroyBuffer(logical_device, buffer->buffer, HOST_ALLOCATOR);
             }
 
         if (buffer->memory != VK_NULL_HANDLE) 
             { 
                 report(LOGGER::VERBOSE, "Management - Freeing Buffer Memory ..");
-                vkFreeMemory(logical_device, buffer->memory, nullptr); 
+                RELEASE_OBJECT(VK_OBJECT_TYPE_DEVICE_MEMORY, buffer->memory);
+                vkFreeMemory(logical_device, buffer->memory, HOST_ALLOCATOR); 
             }
 
         return;
@@ -128,18 +177,33 @@ void NovaCore::destroyComputeResources()
         // destroy compute semaphores and fences
         for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) 
             {
-                vkDestroySemaphore(logical_device, computes[i].finished, nullptr);
-                vkDestroyFence(logical_device, computes[i].in_flight, nullptr);
+                RELEASE_OBJECT(VK_OBJECT_TYPE_SEMAPHORE, computes[i].finished);
+                vkDestroySemaphore(logical_device, computes[i].finished, HOST_ALLOCATOR);
+                RELEASE_OBJECT(VK_OBJECT_TYPE_FENCE, computes[i].in_flight);
+                vkDestroyFence(logical_device, computes[i].in_flight, HOST_ALLOCATOR);
             }
 
         // destroy compute command pool
-        vkDestroyCommandPool(logical_device, queues.compute.pool, nullptr);
+        RELEASE_OBJECT(VK_OBJECT_TYPE_COMMAND_POOL, queues.compute.pool);
+        vkDestroyCommandPool(logical_device, queues.compute.pool, HOST_ALLOCATOR);
 
         // destroy storage buffers
         for (auto& _buffer : storage) 
             { destroyBuffer(&_buffer); }
 
         // destroy compute descriptor set layout
-        vkDestroyDescriptorSetLayout(logical_device, compute_descriptor.layout, nullptr);
+        RELEASE_OBJECT(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, compute_descriptor.layout);
+        PipelineDescriptions::get().forgetSetLayout(compute_descriptor.layout);
+        vkDestroyDescriptorSetLayout(logical_device, compute_descriptor.layout, HOST_ALLOCATOR);
+
+        if (config.binding_backend == BINDING_BINDLESS)
+            { bindless.destroy(&logical_device); }
+
+        if (config.binding_backend == BINDING_DESCRIPTOR_BUFFER)
+            {
+                binder.destroy();
+                vkUnmapMemory(logical_device, descriptor_buffer.memory);
+                destroyBuffer(&descriptor_buffer);
+            }
 
     }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "../../core.h"
+#include <algorithm>
 #include <set>
 #include <string>
 
@@ -74,7 +75,7 @@ void NovaCore::getQueueFamilies(VkPhysicalDevice scanned_device)
                 report(LOGGER::VLINE, "\t\tQueue Family %d", i);
 
                 // If we haven't found a present family yet, we'll take the first one we find
-                if (queues.indices.present_family.value() == -1){
+                if (!config.headless && queues.indices.present_family.value() == -1){
                         VkBool32 _present_support = false;  
                         vkGetPhysicalDeviceSurfaceSupportKHR(scanned_device, i, surface, &_present_support);
 
@@ -89,6 +90,10 @@ void NovaCore::getQueueFamilies(VkPhysicalDevice scanned_device)
                 setQueueFamilyProperties(i);
             }
 
+        // Nothing is presented headless, the graphics queue stands in so the family checks still hold
+        if (config.headless) 
+            { queues.indices.present_family = queues.indices.graphics_family.value(); }
+
         // Check if the queues are complete and set the transfer family to the graphics family if not set
         if (!queues.indices.isComplete()) 
             { 
@@ -114,6 +119,20 @@ static bool checkDeviceExtensionSupport(VkPhysicalDevice device)
         return requiredExtensions.empty();
     }
 
+static bool checkDeviceExtensionSupport(VkPhysicalDevice device, const char* extension_name) 
+    {
+        uint32_t extensionCount;
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+
+        std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
+
+        for (const auto& extension : availableExtensions) 
+            { if (strcmp(extension.extensionName, extension_name) == 0) { return true; } }
+
+        return false;
+    }
+
     ////////////////////////
     //  DEVICE PROVISION  //
     ////////////////////////
@@ -121,6 +140,14 @@ static bool checkDeviceExtensionSupport(VkPhysicalDevice device)
 bool NovaCore::deviceProvisioned(VkPhysicalDevice scanned_device)
     {
         getQueueFamilies(scanned_device);
+
+        VkPhysicalDeviceFeatures supported_features;
+        vkGetPhysicalDeviceFeatures(scanned_device, &supported_features);
+
+        // Without a surface there's no swapchain to support, software drivers like lavapipe qualify
+        if (config.headless)
+            { return queues.indices.isComplete() && supported_features.samplerAnisotropy; }
+
         bool extensions_supported = checkDeviceExtensionSupport(scanned_device);
 
         bool swap_chain_adequate = false;
@@ -130,13 +157,159 @@ bool NovaCore::deviceProvisioned(VkPhysicalDevice scanned_device)
                 swap_chain_adequate = !swap_chain_support.formats.empty() && !swap_chain_support.present_modes.empty();
             }
 
-        VkPhysicalDeviceFeatures supported_features;
-        vkGetPhysicalDeviceFeatures(scanned_device, &supported_features);
-
         return queues.indices.isComplete() && extensions_supported && swap_chain_adequate && supported_features.samplerAnisotropy;
     }
 
 
+    /////////////////////
+    // DEVICE FEATURES //
+    /////////////////////
+
+// Highest extended dynamic state level the queried features allow. 1.3 promoted the first two
+// levels to core (minus the patch control point and logic op parts we don't use), the third is extension only.
+static uint32_t _getDynamicStateLevel(DeviceFeatures& features, uint32_t api_version)
+    {
+        bool _core = api_version >= VK_API_VERSION_1_3;
+
+        if (!_core && !(features.enabled(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME) && features.dynamic_state.extendedDynamicState))
+            { return 0; }
+
+        if (!_core && !(features.enabled(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME) && features.dynamic_state2.extendedDynamicState2))
+            { return 1; }
+
+        if (!features.enabled(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME) 
+                || !features.dynamic_state3.extendedDynamicState3ColorBlendEnable
+                || !features.dynamic_state3.extendedDynamicState3ColorBlendEquation
+                || !features.dynamic_state3.extendedDynamicState3ColorWriteMask)
+            { return 2; }
+
+        return 3;
+    }
+
+static const char* _BINDING_BACKEND_NAMES[] = { "Descriptor Sets", "Bindless", "Push Descriptors", "Descriptor Buffer" };
+
+// Records what the selected device supports and drops any configured option it can't run
+void NovaCore::queryDeviceFeatures()
+    {
+        report(LOGGER::VLINE, "\t .. Querying Device Features ..");
+
+        // Only ask for the optional extensions the config wants and the device has
+        const char* _dynamic_state_extensions[] = { 
+                VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME, 
+                VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME, 
+                VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME 
+            };
+
+        std::vector<const char*> _wanted;
+        for (uint32_t i = 0; i < config.dynamic_state_level && i < 3; i++)
+            {
+                bool _core = i < 2 && device_properties.apiVersion >= VK_API_VERSION_1_3;
+                if (!_core) { _wanted.push_back(_dynamic_state_extensions[i]); }
+            }
+
+        if (config.binding_backend == BINDING_PUSH_DESCRIPTORS) { _wanted.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME); }
+        if (config.binding_backend == BINDING_DESCRIPTOR_BUFFER) { _wanted.push_back(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME); }
+        if (config.trace_path != nullptr) { _wanted.push_back(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME); }
+        // The benchmark summary, the HUD and the control socket's stats all report device memory in use
+        if (config.bench_path != nullptr || config.hud || config.control_path != nullptr) { _wanted.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME); }
+
+        device_features.extensions.clear();
+        for (const char* _extension : _wanted)
+            { if (checkDeviceExtensionSupport(physical_device, _extension)) { device_features.extensions.push_back(_extension); } }
+
+        device_features.chain(device_properties.apiVersion);
+        vkGetPhysicalDeviceFeatures2(physical_device, &device_features.core);
+
+        if (config.dynamic_rendering && (device_properties.apiVersion < VK_API_VERSION_1_3 || !device_features.vulkan13.dynamicRendering))
+            {
+                report(LOGGER::INFO, "NovaCore - Dynamic Rendering Unsupported, Falling Back to Render Passes ..");
+                config.dynamic_rendering = false;
+            }
+
+        if (config.pipeline_statistics && !device_features.core.features.pipelineStatisticsQuery)
+            {
+                report(LOGGER::INFO, "NovaCore - Pipeline Statistics Queries Unsupported, Disabling ..");
+                config.pipeline_statistics = false;
+            }
+
+        VkPhysicalDeviceVulkan12Features& _vulkan12 = device_features.vulkan12;
+        bool _core12 = device_properties.apiVersion >= VK_API_VERSION_1_2;
+        bool _backend_supported = true;
+
+        switch (config.binding_backend)
+            {
+                case BINDING_BINDLESS:
+                    _backend_supported = _core12
+                            && _vulkan12.runtimeDescriptorArray
+                            && _vulkan12.descriptorBindingPartiallyBound
+                            && _vulkan12.descriptorBindingVariableDescriptorCount
+                            && _vulkan12.descriptorBindingStorageBufferUpdateAfterBind
+                            && _vulkan12.descriptorBindingSampledImageUpdateAfterBind;
+                    break;
+                case BINDING_PUSH_DESCRIPTORS:
+                    _backend_supported = device_features.enabled(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+                    break;
+                case BINDING_DESCRIPTOR_BUFFER:
+                    _backend_supported = _core12 && _vulkan12.bufferDeviceAddress
+                            && device_features.enabled(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME) 
+                            && device_features.descriptor_buffer.descriptorBuffer;
+                    break;
+                default:
+                    break;
+            }
+
+        if (!_backend_supported)
+            {
+                report(LOGGER::INFO, "NovaCore - %s Unsupported, Falling Back to Descriptor Sets ..", _BINDING_BACKEND_NAMES[config.binding_backend]);
+                config.binding_backend = BINDING_DESCRIPTOR_SETS;
+            }
+
+        uint32_t _dynamic_state_level = _getDynamicStateLevel(device_features, device_properties.apiVersion);
+        if (config.dynamic_state_level > _dynamic_state_level)
+            {
+                report(LOGGER::INFO, "NovaCore - Extended Dynamic State Limited to Level %u ..", _dynamic_state_level);
+                config.dynamic_state_level = _dynamic_state_level;
+            }
+
+        // The dispatch is one dimensional, so both the workgroup and the group count have to fit the first axis
+        VkPhysicalDeviceLimits& _limits = device_properties.limits;
+        uint32_t _max_workgroup = std::min(_limits.maxComputeWorkGroupSize[0], _limits.maxComputeWorkGroupInvocations);
+        if (config.workgroup_size == 0 || config.workgroup_size > _max_workgroup)
+            {
+                uint32_t _workgroup_size = std::min(256u, _max_workgroup);
+                report(LOGGER::INFO, "NovaCore - Workgroup Size %u Unsupported, Using %u ..", config.workgroup_size, _workgroup_size);
+                config.workgroup_size = _workgroup_size;
+            }
+
+        if (config.particle_count == 0 || (config.particle_count - 1) / config.workgroup_size >= _limits.maxComputeWorkGroupCount[0])
+            {
+                report(LOGGER::ERROR, "NovaCore - %u Particles Can't Be Dispatched in Workgroups of %u ..", config.particle_count, config.workgroup_size);
+                abort();
+            }
+
+        if (config.substeps == 0) { config.substeps = 1; }
+
+        // Drop the extensions for anything we settled below so createLogicalDevice doesn't enable them
+        std::vector<const char*> _extensions;
+        for (uint32_t i = 0; i < config.dynamic_state_level; i++)
+            { if (device_features.enabled(_dynamic_state_extensions[i])) { _extensions.push_back(_dynamic_state_extensions[i]); } }
+
+        if (config.binding_backend == BINDING_PUSH_DESCRIPTORS) { _extensions.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME); }
+        if (config.binding_backend == BINDING_DESCRIPTOR_BUFFER) { _extensions.push_back(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME); }
+        if (device_features.enabled(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME)) { _extensions.push_back(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME); }
+        if (device_features.enabled(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)) { _extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME); }
+
+        device_features.extensions = _extensions;
+
+        report(LOGGER::DLINE, "\t\tDynamic Rendering: %s", config.dynamic_rendering ? "enabled" : "disabled");
+        report(LOGGER::DLINE, "\t\tExtended Dynamic State: %u", config.dynamic_state_level);
+        report(LOGGER::DLINE, "\t\tBinding Backend: %s", _BINDING_BACKEND_NAMES[config.binding_backend]);
+        report(LOGGER::DLINE, "\t\tWorkgroup Size: %u", config.workgroup_size);
+
+        return;
+    }
+
+
     //////////////////////////
     // PHYSICAL DEVICE INFO //
     //////////////////////////
@@ -176,6 +349,8 @@ static inline VkPhysicalDeviceSubgroupProperties getSubgroupProperties(VkPhysica
 
 void NovaCore::createPhysicalDevice() 
     {
+        STARTUP_STAGE();
+
         report(LOGGER::VLINE, "\t .. Scanning for Physical Devices ..");
 
         uint32_t device_count = 0;
@@ -203,6 +378,7 @@ void NovaCore::createPhysicalDevice()
                         report(LOGGER::DLINE, "\tUsing Device: %s", device_properties.deviceName);
 
                         physical_device = device;
+                        this->device_properties = device_properties;
                         msaa_samples = getMaxUsableSampleCount(&physical_device); // Need to build a device struct to hold relevant information
                         subgroup_properties = getSubgroupProperties(physical_device);
                         // get physical device limits
@@ -219,8 +395,11 @@ void NovaCore::createPhysicalDevice()
             }
 
 
+
         if (physical_device == VK_NULL_HANDLE) 
-            { report(LOGGER::ERROR, "Vulkan: Failed to find a suitable GPU"); }
+            { report(LOGGER::ERROR, "Vulkan: Failed to find a suitable GPU"); return; }
+
+        queryDeviceFeatures();
 
         return;
     }
@@ -242,9 +421,33 @@ VkDeviceQueueCreateInfo NovaCore::getQueueCreateInfo(uint32_t queue_family)
 
 void NovaCore::createLogicalDevice()
     {
+        STARTUP_STAGE();
+
         report(LOGGER::VLINE, "\t .. Creating Logical Device ..");
-        VkPhysicalDeviceFeatures _device_features = {};
-        _device_features.samplerAnisotropy = VK_TRUE;
+        DeviceFeatures _device_features = {};
+        _device_features.extensions = device_features.extensions;
+        _device_features.chain(device_properties.apiVersion);
+        _device_features.core.features.samplerAnisotropy = VK_TRUE;
+        _device_features.core.features.pipelineStatisticsQuery = config.pipeline_statistics;
+        _device_features.vulkan13.dynamicRendering = config.dynamic_rendering;
+
+        bool _bindless = config.binding_backend == BINDING_BINDLESS;
+        _device_features.vulkan12.runtimeDescriptorArray = _bindless;
+        _device_features.vulkan12.descriptorBindingPartiallyBound = _bindless;
+        _device_features.vulkan12.descriptorBindingVariableDescriptorCount = _bindless;
+        _device_features.vulkan12.descriptorBindingStorageBufferUpdateAfterBind = _bindless;
+        _device_features.vulkan12.descriptorBindingSampledImageUpdateAfterBind = _bindless;
+        _device_features.vulkan12.shaderStorageBufferArrayNonUniformIndexing = _bindless && device_features.vulkan12.shaderStorageBufferArrayNonUniformIndexing;
+        _device_features.vulkan12.shaderSampledImageArrayNonUniformIndexing = _bindless && device_features.vulkan12.shaderSampledImageArrayNonUniformIndexing;
+
+        bool _descriptor_buffer = config.binding_backend == BINDING_DESCRIPTOR_BUFFER;
+        _device_features.vulkan12.bufferDeviceAddress = _descriptor_buffer;
+        _device_features.descriptor_buffer.descriptorBuffer = _descriptor_buffer;
+        _device_features.dynamic_state.extendedDynamicState = config.dynamic_state_level >= 1;
+        _device_features.dynamic_state2.extendedDynamicState2 = config.dynamic_state_level >= 2;
+        _device_features.dynamic_state3.extendedDynamicState3ColorBlendEnable = config.dynamic_state_level >= 3;
+        _device_features.dynamic_state3.extendedDynamicState3ColorBlendEquation = config.dynamic_state_level >= 3;
+        _device_features.dynamic_state3.extendedDynamicState3ColorWriteMask = config.dynamic_state_level >= 3;
 
         std::vector<VkDeviceQueueCreateInfo> _queue_create_infos;
         std::set<uint32_t> _unique_queue_families = {
@@ -271,18 +474,27 @@ void NovaCore::createLogicalDevice()
                 sType: VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
                 queueCreateInfoCount: static_cast<uint32_t>(_queue_create_infos.size()),
                 pQueueCreateInfos: _queue_create_infos.data(),
-                pEnabledFeatures: &_device_features,
+                pEnabledFeatures: nullptr,
             };
 
-        create_info.enabledExtensionCount = static_cast<uint32_t>(DEVICE_EXTENSIONS.size());
-        create_info.ppEnabledExtensionNames = DEVICE_EXTENSIONS.data();
+        create_info.pNext = &_device_features.core;
+
+        std::vector<const char*> _extensions = config.headless ? std::vector<const char*>() : DEVICE_EXTENSIONS;
+        _extensions.insert(_extensions.end(), device_features.extensions.begin(), device_features.extensions.end());
 
-        VK_TRY(vkCreateDevice(physical_device, &create_info, nullptr, &logical_device));
+        create_info.enabledExtensionCount = static_cast<uint32_t>(_extensions.size());
+        create_info.ppEnabledExtensionNames = _extensions.data();
+
+        VK_TRY(vkCreateDevice(physical_device, &create_info, HOST_ALLOCATOR, &logical_device));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_DEVICE, logical_device, 0);
 
         vkGetDeviceQueue(logical_device, queues.indices.graphics_family.value(), 0, &queues.graphics);
         vkGetDeviceQueue(logical_device, queues.indices.present_family.value(), 0, &queues.present);
         vkGetDeviceQueue(logical_device, queues.indices.compute_family.value(), 0, &queues.compute.queue);
         vkGetDeviceQueue(logical_device, queues.indices.transfer_family.value(), 0, &queues.transfer.queue);
 
+        loadDynamicStateCommands();
+        binder.init(&logical_device, physical_device, config.binding_backend);
+
         //log();
     }
\ No newline at end of file
@@ -1,18 +1,19 @@
 #include "../../core.h"
 
 #include <SDL2/SDL_vulkan.h>
-#include <SDL2/SDL_timer.h>
 
     ////////////////////////
     //  INSTANCE CREATION //
     ////////////////////////
 
-NovaCore::NovaCore(VkExtent2D extent) 
+NovaCore::NovaCore(VkExtent2D extent, EngineConfig engine_config) 
     {
         _blankContext();
+        config = engine_config;
         setWindowExtent(extent);
         createVulkanInstance();
-        last_time = SDL_GetTicks64() / 1000.0;
+        frame_stats.setInterval(config.frame_stats_interval);
+        last_time = frame_stats.seconds();
 
         // TODO: Inline Initialization to be done here instead of the constructor of the top level
         // 
@@ -42,6 +43,8 @@ NovaCore::NovaCore(VkExtent2D extent)
 
 void NovaCore::createVulkanInstance() 
     {
+        STARTUP_STAGE();
+
         report(LOGGER::VLINE, "\t .. Instantiating Engine ..");
         VkApplicationInfo app_info = {
             .sType = VK_STRUCTURE_TYPE_APPLICATION_INFO,
@@ -62,8 +65,9 @@ void NovaCore::createVulkanInstance()
         
         uint32_t extension_count = 0;
         
-        // This is part of the code that only gets the required extensions by SDL.
-        SDL_Vulkan_GetInstanceExtensions(nullptr, &extension_count, nullptr);
+        // This is part of the code that only gets the required extensions by SDL. Headless needs none of them.
+        if (!config.headless)
+            { SDL_Vulkan_GetInstanceExtensions(nullptr, &extension_count, nullptr); }
 
         // This is part of the code that gets all extensions supported by the system.
         // vkEnumerateInstanceExtensionProperties(nullptr, &extension_count, nullptr); 
@@ -72,7 +76,8 @@ void NovaCore::createVulkanInstance()
         std::vector<const char*> extensions(extension_count);
 
         // This code gets only the required extensions by SDL, and append the debug extension.
-        SDL_Vulkan_GetInstanceExtensions(nullptr, &extension_count, extensions.data());
+        if (!config.headless)
+            { SDL_Vulkan_GetInstanceExtensions(nullptr, &extension_count, extensions.data()); }
         
         if (USE_VALIDATION_LAYERS)
             {
@@ -124,7 +129,8 @@ void NovaCore::createVulkanInstance()
                 create_info.pNext = nullptr;
             }
 
-        VK_TRY(vkCreateInstance(&create_info, nullptr, &instance));
+        VK_TRY(vkCreateInstance(&create_info, HOST_ALLOCATOR, &instance));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_INSTANCE, instance, 0);
     }
 
 
@@ -180,7 +186,8 @@ static SwapChainContext initSwapchain() {
             .image_views = {},
             .framebuffers = {},
             .support = initSwapChainSupport(),
-            .details = initSwapChainDetails()
+            .details = initSwapChainDetails(),
+            .retired = {}
         };
 }
 
@@ -200,6 +207,11 @@ void NovaCore::_blankContext()
 
         instance = VK_NULL_HANDLE;
         physical_device = VK_NULL_HANDLE;
+        device_properties = {};
+        device_features = {};
+        dynamic_state = {};
+        render_state = {};
+        simulation = {};
         logical_device = VK_NULL_HANDLE;
         surface = VK_NULL_HANDLE;
         render_pass = VK_NULL_HANDLE;
@@ -208,6 +220,8 @@ void NovaCore::_blankContext()
         present = {};
         graphics_pipeline = nullptr;
         compute_pipeline = nullptr;
+        hud_pipeline = nullptr;
+        for (auto& _quads : hud_quads) { _quads = {}; }
         vertex = {};
         index = {};
         uniform = {};
@@ -217,7 +231,6 @@ void NovaCore::_blankContext()
         texture = _initImageContext();
         descriptor = {
             .layout = VK_NULL_HANDLE,
-            .pool = VK_NULL_HANDLE,
             .sets = {}
         };
     }
@@ -6,8 +6,13 @@
 
 void NovaCore::createFrameBuffers()
     {
+        STARTUP_STAGE();
+
         report(LOGGER::VLINE, "Presentation - Creating Frame Buffers ..");
 
+        if (config.dynamic_rendering)
+            { report(LOGGER::VLINE, "\t .. Dynamic Rendering, No Frame Buffers Needed .."); return; }
+
         swapchain.framebuffers.resize(swapchain.image_views.size());
 
         for (size_t i = 0; i < swapchain.image_views.size(); i++) 
@@ -30,7 +35,8 @@ void NovaCore::createFrameBuffers()
                     .layers = 1
                 };
 
-                VK_TRY(vkCreateFramebuffer(logical_device, &_create_info, nullptr, &swapchain.framebuffers[i]));
+                VK_TRY(vkCreateFramebuffer(logical_device, &_create_info, HOST_ALLOCATOR, &swapchain.framebuffers[i]));
+                REGISTER_OBJECT(VK_OBJECT_TYPE_FRAMEBUFFER, swapchain.framebuffers[i], 0);
             }
 
         return;
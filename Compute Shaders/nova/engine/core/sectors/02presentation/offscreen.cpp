@@ -0,0 +1,38 @@
+#include "../../core.h"
+
+
+    ///////////////////////
+    // OFFSCREEN TARGETS //
+    ///////////////////////
+
+// Headless stand-in for the swapchain. One device local image per frame in flight fills
+// swapchain.images, so recording and framebuffers don't need to know which they're drawing into.
+// The images finish each frame in TRANSFER_SRC_OPTIMAL, ready to be read back.
+void NovaCore::constructOffscreenTargets()
+    {
+        STARTUP_STAGE();
+
+        report(LOGGER::VLINE, "\t .. Constructing Offscreen Targets ..");
+
+        swapchain.details.surface = { .format = VK_FORMAT_B8G8R8A8_UNORM, .colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR };
+        swapchain.details.present_mode = VK_PRESENT_MODE_FIFO_KHR;
+        swapchain.images.resize(MAX_FRAMES_IN_FLIGHT);
+
+        for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+            {
+                VkDeviceMemory _memory;     // released with the image by the deletion queue
+                createImage(swapchain.details.extent.width, swapchain.details.extent.height, 1, VK_SAMPLE_COUNT_1_BIT, 
+                            swapchain.details.surface.format, VK_IMAGE_TILING_OPTIMAL, 
+                            VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, 
+                            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, swapchain.images[i], _memory);
+            }
+
+        report(LOGGER::INFO, "Presentation - Headless, %u Offscreen Images at %u x %u ..", 
+                MAX_FRAMES_IN_FLIGHT, swapchain.details.extent.width, swapchain.details.extent.height);
+
+        return;
+    }
+
+// Layout the color target is left in at the end of a frame
+VkImageLayout NovaCore::getTargetLayout()
+    { return config.headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR; }
@@ -1,5 +1,6 @@
 #include "../../core.h"
 #include <set> 
+#include <algorithm>
 
     ///////////////////////////////
     //  Virtual Swapchain Layers //
@@ -49,18 +50,30 @@ static void selectSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& avail
         return;
     }
 
-static void selectSwapPresentMode(const std::vector<VkPresentModeKHR>& available_present_modes, VkPresentModeKHR* present_mode)
+static inline std::vector<VkPresentModeKHR> _getPresentModePreference(PRESENT_POLICY policy)
     {
-        report(LOGGER::VLINE, "\t .. Selecting Swap Present Mode ..");
-
-        for (const auto& available_present_mode : available_present_modes) 
+        switch (policy)
             {
-                if (available_present_mode == VK_PRESENT_MODE_MAILBOX_KHR) 
-                    { *present_mode = available_present_mode; }
+                case PRESENT_LATENCY: return { VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_FIFO_RELAXED_KHR, VK_PRESENT_MODE_FIFO_KHR };
+                case PRESENT_THROUGHPUT: return { VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_FIFO_RELAXED_KHR, VK_PRESENT_MODE_FIFO_KHR };
+                case PRESENT_UNCAPPED: return { VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_FIFO_RELAXED_KHR, VK_PRESENT_MODE_FIFO_KHR };
+                default: return { VK_PRESENT_MODE_FIFO_KHR };
             }
+    }
+
+// First of the policy's modes the surface offers, FIFO is guaranteed so it ends every list
+static void selectSwapPresentMode(const std::vector<VkPresentModeKHR>& available_present_modes, PRESENT_POLICY policy, VkPresentModeKHR* present_mode)
+    {
+        report(LOGGER::VLINE, "\t .. Selecting Swap Present Mode ..");
 
         *present_mode = VK_PRESENT_MODE_FIFO_KHR;
 
+        for (const auto& preferred_present_mode : _getPresentModePreference(policy)) 
+            {
+                if (std::find(available_present_modes.begin(), available_present_modes.end(), preferred_present_mode) != available_present_modes.end()) 
+                    { *present_mode = preferred_present_mode; break; }
+            }
+
         return;
     }
 
@@ -92,13 +105,13 @@ void NovaCore::querySwapChainDetails()
             { report(LOGGER::ERROR, "Vulkan: SwapChain support is not available."); }
 
         selectSwapSurfaceFormat(swapchain.support.formats, &swapchain.details.surface);
-        selectSwapPresentMode(swapchain.support.present_modes, &swapchain.details.present_mode);
+        selectSwapPresentMode(swapchain.support.present_modes, config.present_policy, &swapchain.details.present_mode);
         selectSwapExtent(swapchain.support.capabilities, &swapchain.details.extent);
 
         return;
     }
 
-void NovaCore::createSwapchainInfoKHR(VkSwapchainCreateInfoKHR* create_info, uint32_t image_count) 
+void NovaCore::createSwapchainInfoKHR(VkSwapchainCreateInfoKHR* create_info, uint32_t image_count, VkSwapchainKHR old_swapchain) 
     {
         *create_info = {
             .sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
@@ -116,27 +129,56 @@ void NovaCore::createSwapchainInfoKHR(VkSwapchainCreateInfoKHR* create_info, uin
             .compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR,
             .presentMode = swapchain.details.present_mode,
             .clipped = VK_TRUE,
-            .oldSwapchain = VK_NULL_HANDLE
+            .oldSwapchain = old_swapchain
         };
     }
 
 // TODO: Wrap this in a class where we can just delete and recreate the swapchain using a singleton wrapper
 void NovaCore::constructSwapChain() 
     {
+        STARTUP_STAGE();
+
         report(LOGGER::VLINE, "\t .. Constructing SwapChain ..");
 
+        if (config.headless)
+            { constructOffscreenTargets(); return; }
+
         swapchain.support = querySwapChainSupport(physical_device);
 
         querySwapChainDetails();
 
-        uint32_t _image_count = swapchain.support.capabilities.minImageCount + 1;
+        uint32_t _image_count = swapchain.support.capabilities.minImageCount + (config.present_policy == PRESENT_THROUGHPUT ? 2 : 1);
 
         if (swapchain.support.capabilities.maxImageCount > 0 && _image_count > swapchain.support.capabilities.maxImageCount) 
             { _image_count = swapchain.support.capabilities.maxImageCount; }
 
         //log();
         VkSwapchainCreateInfoKHR _create_info = {}; // TODO: This could be 1 line
-        createSwapchainInfoKHR(&_create_info, _image_count);
+        createSwapchainInfoKHR(&_create_info, _image_count, swapchain.instance);   // hands off the old chain when recreating
+
+        // Captures copy straight out of the swapchain images
+        if (config.capture_interval)
+            {
+                if (swapchain.support.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
+                    { _create_info.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT; }
+                else
+                    {
+                        report(LOGGER::INFO, "NovaCore - Swapchain Images Can't Be Copied, Capture Disabled ..");
+                        config.capture_interval = 0;
+                    }
+            }
+
+        // Dynamic resolution blits the scaled scene up into the swapchain image
+        if (config.dynamic_resolution)
+            {
+                if (swapchain.support.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT)
+                    { _create_info.imageUsage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT; }
+                else
+                    {
+                        report(LOGGER::INFO, "NovaCore - Swapchain Images Can't Be Blitted To, Dynamic Resolution Disabled ..");
+                        config.dynamic_resolution = false;
+                    }
+            }
 
         std::set<uint32_t> _unique_queue_families = { queues.indices.graphics_family.value(), queues.indices.present_family.value(), queues.indices.transfer_family.value(), queues.indices.compute_family.value() };
         std::vector<uint32_t> _queue_families(_unique_queue_families.begin(), _unique_queue_families.end());
@@ -167,36 +209,108 @@ void NovaCore::constructSwapChain()
                 _create_info.pNext = &_scalability_info;
             }
 
-        VK_TRY(vkCreateSwapchainKHR(logical_device, &_create_info, nullptr, &swapchain.instance));
+        VK_TRY(vkCreateSwapchainKHR(logical_device, &_create_info, HOST_ALLOCATOR, &swapchain.instance));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_SWAPCHAIN_KHR, swapchain.instance, 0);
 
         vkGetSwapchainImagesKHR(logical_device, swapchain.instance, &_image_count, nullptr);
         swapchain.images.resize(_image_count);
         vkGetSwapchainImagesKHR(logical_device, swapchain.instance, &_image_count, swapchain.images.data());
 
-        report(LOGGER::VLINE, "\t .. SwapChain Constructed ..");
+        report(LOGGER::INFO, "Presentation - %u Images, %s ..", _image_count, string_VkPresentModeKHR(swapchain.details.present_mode));
 
         return;
     }
 
+// Rebuilds the swapchain under the new policy, returns the present mode the surface actually gave us
+VkPresentModeKHR NovaCore::setPresentPolicy(PRESENT_POLICY policy)
+    {
+        report(LOGGER::VERBOSE, "Presentation - Setting Present Policy ..");
+
+        if (policy == config.present_policy || config.headless) 
+            { return swapchain.details.present_mode; }
+
+        config.present_policy = policy;
+        recreateSwapChain();
+
+        return swapchain.details.present_mode;
+    }
+
+// No device wait, the old chain is handed to the new one as oldSwapchain and parked until
+// the frames that recorded against it have retired. constructSwapChain requeries the surface.
 void NovaCore::recreateSwapChain() 
     {
         report(LOGGER::VERBOSE, "Presentation - Recreating Swapchain ..");
 
-        vkDeviceWaitIdle(logical_device);
-        destroySwapChain();
-
-        // TODO: Try chasing this down without the validation layer bugs being blocked 
-        // to see if OUTOFDATE_KHR is the issue or if it is SUBOPTIMAL_KHR
-        if (framebuffer_resized) {
-            swapchain.support = querySwapChainSupport(physical_device);
-            querySwapChainDetails();
-        }
+        VkSwapchainKHR _old_swapchain = swapchain.instance;
+        VkFormat _old_format = swapchain.details.surface.format;
 
         constructSwapChain();
+        retireSwapChain(_old_swapchain);
+
+        // Before the framebuffers, which are made against the render pass
+        if (swapchain.details.surface.format != _old_format) { rebuildForSurfaceFormat(); }
         constructImageViews();
+        createRenderTargets();
         //createColorResources();
         //createDepthResources();
         createFrameBuffers();
         return;
     }
 
+
+    //////////////////////////
+    // SWAPCHAIN RETIREMENT //
+    //////////////////////////
+
+// Every frame up to this one may have recorded against the old chain, and the fence wait at the
+// start of frame_number + MAX_FRAMES_IN_FLIGHT is the first to cover all of them.
+void NovaCore::retireSwapChain(VkSwapchainKHR old_swapchain)
+    {
+        report(LOGGER::VLINE, "\t .. Retiring SwapChain ..");
+
+        swapchain.retired.push_back({
+                .instance = old_swapchain,
+                .image_views = std::move(swapchain.image_views),
+                .framebuffers = std::move(swapchain.framebuffers),
+                .render_targets = std::move(render_targets),
+                .retire_frame = frame_number + MAX_FRAMES_IN_FLIGHT
+            });
+
+        swapchain.image_views.clear();
+        swapchain.framebuffers.clear();
+        render_targets.clear();
+
+        return;
+    }
+
+// Called once the frame fences are waited on, or with everything at teardown once the device is idle
+void NovaCore::destroyRetiredSwapChains(bool all)
+    {
+        while (!swapchain.retired.empty() && (all || swapchain.retired.front().retire_frame <= frame_number))
+            {
+                RetiredSwapChain& _retired = swapchain.retired.front();
+
+                report(LOGGER::VLINE, "\t .. Destroying Retired SwapChain ..");
+
+                for (const auto& _frame_buffer : _retired.framebuffers) 
+                    {
+                        RELEASE_OBJECT(VK_OBJECT_TYPE_FRAMEBUFFER, _frame_buffer);
+                        vkDestroyFramebuffer(logical_device, _frame_buffer, HOST_ALLOCATOR);
+                    }
+
+                for (const auto& _image_view : _retired.image_views) 
+                    {
+                        RELEASE_OBJECT(VK_OBJECT_TYPE_IMAGE_VIEW, _image_view);
+                        vkDestroyImageView(logical_device, _image_view, HOST_ALLOCATOR);
+                    }
+
+                destroyRenderTargets(_retired.render_targets);
+                RELEASE_OBJECT(VK_OBJECT_TYPE_SWAPCHAIN_KHR, _retired.instance);
+                vkDestroySwapchainKHR(logical_device, _retired.instance, HOST_ALLOCATOR);
+
+                swapchain.retired.pop_front();
+            }
+
+        return;
+    }
+
@@ -25,13 +25,27 @@ void NovaCore::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemor
         report(LOGGER::VLINE, "\t\t .. Creating Buffer ..");
 
         VkBufferCreateInfo _buffer_info = getBufferInfo(size, usage);
-        VK_TRY(vkCreateBuffer(logical_device, &_buffer_info, nullptr, &buffer->buffer));
+        VK_TRY(vkCreateBuffer(logical_device, &_buffer_info, HOST_ALLOCATOR, &buffer->buffer));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_BUFFER, buffer->buffer, _buffer_info.size);
 
         VkMemoryRequirements _mem_reqs;
         vkGetBufferMemoryRequirements(logical_device, buffer->buffer, &_mem_reqs);
 
         VkMemoryAllocateInfo _alloc_info = getMemoryAllocateInfo(_mem_reqs, properties);
-        VK_TRY(vkAllocateMemory(logical_device, &_alloc_info, nullptr, &buffer->memory));
+
+        // Buffers read through a device address need memory that can hand one out
+        VkMemoryAllocateFlagsInfo _alloc_flags = {
+                .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO,
+                .pNext = nullptr,
+                .flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT,
+                .deviceMask = 0
+            };
+
+        if (usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+            { _alloc_info.pNext = &_alloc_flags; }
+
+        VK_TRY(vkAllocateMemory(logical_device, &_alloc_info, HOST_ALLOCATOR, &buffer->memory));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_DEVICE_MEMORY, buffer->memory, _alloc_info.allocationSize);
 
         vkBindBufferMemory(logical_device, buffer->buffer, buffer->memory, 0);
 
@@ -1,6 +1,8 @@
 #include "../../core.h"
 #include "../00atomic/particle.h"
 
+#include <algorithm>
+
     ///////////////////////////
     // DESCRIPTOR SET LAYOUT //
     ///////////////////////////
@@ -27,10 +29,11 @@ static inline VkDescriptorSetLayoutBinding _getFragmentLayoutBinding()
             };
     }
 
-static inline VkDescriptorSetLayoutCreateInfo _getLayoutInfo(std::vector<VkDescriptorSetLayoutBinding>& bindings)
+static inline VkDescriptorSetLayoutCreateInfo _getLayoutInfo(std::vector<VkDescriptorSetLayoutBinding>& bindings, VkDescriptorSetLayoutCreateFlags flags = 0)
     {
         return {
                 sType: VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+                flags: flags,
                 bindingCount: static_cast<uint32_t>(bindings.size()),
                 pBindings: bindings.data()
             };
@@ -49,85 +52,36 @@ void NovaCore::createDescriptorSetLayout()
         };
         VkDescriptorSetLayoutCreateInfo _layout_info = _getLayoutInfo(_layout_binding);
 
-        VK_TRY(vkCreateDescriptorSetLayout(logical_device, &_layout_info, nullptr, &descriptor.layout));
+        VK_TRY(vkCreateDescriptorSetLayout(logical_device, &_layout_info, HOST_ALLOCATOR, &descriptor.layout));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, descriptor.layout, 0);
+        PipelineDescriptions::get().describeSetLayout(descriptor.layout, _layout_info);
 
         return;
     }
 
-static inline VkDescriptorPoolSize _getUniformPoolSize(uint32_t ct)
-    {
-        report(LOGGER::VLINE, "\t\t .. Creating Descriptor Pool Size of %d ..", ct);
-
-        return {
-            .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            .descriptorCount = ct
-        };
-    }
-
-static inline VkDescriptorPoolSize _getSamplerPoolSize(uint32_t ct)
-    {
-        report(LOGGER::VLINE, "\t\t .. Creating Descriptor Pool Size of %d ..", ct);
-
-        return {
-            .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            .descriptorCount = ct
-        };
-    }
-
-static inline VkDescriptorPoolSize _getStorageBufferPoolSize(uint32_t ct)
-    {
-        report(LOGGER::VLINE, "\t\t .. Creating Descriptor Pool Size of %d ..", ct);
-
-        return {
-            .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-            .descriptorCount = ct
-        };
-    }
-
-static inline VkDescriptorPoolCreateInfo _getPoolInfo(uint32_t ct, std::array<VkDescriptorPoolSize, 2>& sizes)
+// Rough mix of descriptors per set across the passes we have, the allocator chains more pools if it's off
+static inline std::vector<DescriptorAllocator::PoolRatio> _getPoolRatios()
     {
-        report(LOGGER::VLINE, "\t\t .. Creating Descriptor Pools Info with size %d ..", sizes.size());
-
         return {
-            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
-            .pNext = nullptr,
-            .flags = 0,
-            .maxSets = ct,
-            .poolSizeCount = static_cast<uint32_t>(sizes.size()),
-            .pPoolSizes = sizes.data()
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1.0f },
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2.0f },
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1.0f }
         };
     }
 
+// Every set we have lives for the life of the context, a pass that writes sets per frame
+// would want its own allocator per frame in flight, reset once that slot's fences signal
 void NovaCore::constructDescriptorPool() 
     {
-        report(LOGGER::VLINE, "\t .. Constructing Descriptor Pool ..");
-
-        std::array<VkDescriptorPoolSize, 2> _pool_size = {
-            _getUniformPoolSize(MAX_FRAMES_IN_FLIGHT),
-            //_getSamplerPoolSize(MAX_FRAMES_IN_FLIGHT)
-            _getStorageBufferPoolSize(MAX_FRAMES_IN_FLIGHT * 2)
-        };
+        STARTUP_STAGE();
 
-        VkDescriptorPoolCreateInfo _pool_info = _getPoolInfo(MAX_FRAMES_IN_FLIGHT, _pool_size);
+        report(LOGGER::VLINE, "\t .. Constructing Descriptor Allocator ..");
 
-        VK_TRY(vkCreateDescriptorPool(logical_device, &_pool_info, nullptr, &descriptor.pool));
+        descriptor_allocator.init(&logical_device, MAX_FRAMES_IN_FLIGHT * 2, _getPoolRatios());
 
         return;
     }
 
-static inline VkDescriptorSetAllocateInfo _getDescriptorSetAllocateInfo(uint32_t ct, VkDescriptorPool* pool, std::vector<VkDescriptorSetLayout>& layouts)
-    {
-        report(LOGGER::VLINE, "\t\t .. Creating Descriptor Set Allocate Info ..");
-
-        return {
-            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-            .pNext = nullptr,
-            .descriptorPool = *pool,
-            .descriptorSetCount = ct,
-            .pSetLayouts = layouts.data()
-        };
-    }
-
 static inline VkDescriptorBufferInfo _getDescriptorBufferInfo(VkBuffer* buffer, VkDeviceSize size)
     {
         report(LOGGER::VLINE, "\t\t .. Creating Descriptor Buffer Info ..");
@@ -190,15 +144,12 @@ void NovaCore::createDescriptorSets()
     {
         report(LOGGER::VLINE, "\t .. Creating Descriptor Sets ..");
 
-        std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, descriptor.layout);
-        VkDescriptorSetAllocateInfo _alloc_info = _getDescriptorSetAllocateInfo(static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT), &descriptor.pool, layouts);
-
         descriptor.sets.resize(MAX_FRAMES_IN_FLIGHT);
 
-        VK_TRY(vkAllocateDescriptorSets(logical_device, &_alloc_info, descriptor.sets.data()));
-
         for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) 
             {
+                descriptor.sets[i] = descriptor_allocator.allocate(&logical_device, descriptor.layout);
+
                 VkDescriptorBufferInfo _buffer_info = _getDescriptorBufferInfo(&uniform[i].buffer, sizeof(MVP));
                 VkDescriptorImageInfo _image_info = _getDescriptorImageInfo(&texture);
                 
@@ -217,7 +168,7 @@ static inline VkDescriptorSetLayoutBinding constructComputeDescriptorSetLayoutBi
 
         return {
             .binding = i,
-            .descriptorType = (i == 0) ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
             .descriptorCount = 1,
             .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
             .pImmutableSamplers = nullptr
@@ -227,16 +178,58 @@ static inline VkDescriptorSetLayoutBinding constructComputeDescriptorSetLayoutBi
 // TODO: Create a more dynamic way to create variable descriptor set layouts
 void NovaCore::createComputeDescriptorSetLayout()
     {
+        STARTUP_STAGE();
+
         report(LOGGER::DLINE, "\t .. Creating Compute Descriptor Set Layout ..");
 
         std::vector<VkDescriptorSetLayoutBinding> _layout_binding;
 
-        for (size_t i = 0; i < 3; i++)
+        // Particles in and out, the simulation parameters are push constants
+        for (size_t i = 0; i < 2; i++)
             { _layout_binding.push_back(constructComputeDescriptorSetLayoutBinding(i)); }
 
-        VkDescriptorSetLayoutCreateInfo _layout_info = _getLayoutInfo(_layout_binding);
+        // Push descriptors and descriptor buffers have to be told at layout creation
+        VkDescriptorSetLayoutCreateInfo _layout_info = _getLayoutInfo(_layout_binding, binder.layoutFlags());
 
-        VK_TRY(vkCreateDescriptorSetLayout(logical_device, &_layout_info, nullptr, &compute_descriptor.layout));
+        VK_TRY(vkCreateDescriptorSetLayout(logical_device, &_layout_info, HOST_ALLOCATOR, &compute_descriptor.layout));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, compute_descriptor.layout, 0);
+        PipelineDescriptions::get().describeSetLayout(compute_descriptor.layout, _layout_info);
+    }
+
+// Capacities are clamped to the update-after-bind limits, samplers are the variable count binding
+void NovaCore::createBindlessTable()
+    {
+        STARTUP_STAGE();
+
+        if (config.binding_backend != BINDING_BINDLESS) { return; }
+
+        report(LOGGER::DLINE, "\t .. Creating Bindless Table ..");
+
+        VkPhysicalDeviceVulkan12Properties _vulkan12_properties = {
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES,
+                .pNext = nullptr
+            };
+
+        VkPhysicalDeviceProperties2 _properties = {
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+                .pNext = &_vulkan12_properties
+            };
+
+        vkGetPhysicalDeviceProperties2(physical_device, &_properties);
+
+        uint32_t _buffer_ct = std::min({ 8192u, 
+                _vulkan12_properties.maxDescriptorSetUpdateAfterBindStorageBuffers, 
+                _vulkan12_properties.maxPerStageDescriptorUpdateAfterBindStorageBuffers });
+        uint32_t _image_ct = std::min({ 8192u, 
+                _vulkan12_properties.maxDescriptorSetUpdateAfterBindSampledImages, 
+                _vulkan12_properties.maxPerStageDescriptorUpdateAfterBindSampledImages });
+        uint32_t _sampler_ct = std::min({ 1024u, 
+                _vulkan12_properties.maxDescriptorSetUpdateAfterBindSamplers, 
+                _vulkan12_properties.maxPerStageDescriptorUpdateAfterBindSamplers });
+
+        bindless.create(&logical_device, _buffer_ct, _image_ct, _sampler_ct);
+
+        return;
     }
 
 // TODO: Combine all the Descriptor Write Functions with a default parameter set and a 'constructor' function
@@ -258,27 +251,56 @@ static inline VkWriteDescriptorSet _getStorageDescriptorWrite(VkDescriptorSet* s
 
 void NovaCore::createComputeDescriptorSets()
     {
+        STARTUP_STAGE();
+
         report(LOGGER::DLINE, "\t .. Creating Compute Descriptor Sets ..");
 
-        std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, compute_descriptor.layout);
-        VkDescriptorSetAllocateInfo _alloc_info = _getDescriptorSetAllocateInfo(static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT), &descriptor.pool, layouts);
+        // Bindless only needs the buffers registered, the dispatch pushes which slots to ping-pong between
+        if (config.binding_backend == BINDING_BINDLESS)
+            {
+                storage_slots.resize(MAX_FRAMES_IN_FLIGHT);
+
+                for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+                    { storage_slots[i] = bindless.registerBuffer(&logical_device, storage[i].buffer, 0, sizeof(Particle) * config.particle_count); }
+
+                return;
+            }
+
+        // Push descriptors write the buffers at record time, there's nothing to allocate
+        if (config.binding_backend == BINDING_PUSH_DESCRIPTORS)
+            { return; }
+
+        // Descriptor buffers only need somewhere to write them, one region per frame in flight
+        if (config.binding_backend == BINDING_DESCRIPTOR_BUFFER)
+            {
+                VkDeviceSize _region_size = binder.regionSize(compute_descriptor.layout);
+
+                createBuffer(_region_size * MAX_FRAMES_IN_FLIGHT, 
+                        VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, 
+                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &descriptor_buffer);
+
+                void* _mapped;
+                VK_TRY(vkMapMemory(logical_device, descriptor_buffer.memory, 0, VK_WHOLE_SIZE, 0, &_mapped));
+                binder.attach(descriptor_buffer, _mapped, _region_size);
+
+                return;
+            }
 
         compute_descriptor.sets.resize(MAX_FRAMES_IN_FLIGHT);
-        VK_TRY(vkAllocateDescriptorSets(logical_device, &_alloc_info, compute_descriptor.sets.data()));
 
         for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
             {
+                compute_descriptor.sets[i] = descriptor_allocator.allocate(&logical_device, compute_descriptor.layout);
+
                 report(LOGGER::DLINE, "\t\t .. Updating Descriptor Set %u ..", i);
-                VkDescriptorBufferInfo _buffer_info = _getDescriptorBufferInfo(&uniform[i].buffer, sizeof(UBO_T));
 
-                std::array<VkWriteDescriptorSet, 3> _write_descriptor{};
-                _write_descriptor[0] = _getUniformDescriptorWrite(&compute_descriptor.sets[i], &_buffer_info);
+                std::array<VkWriteDescriptorSet, 2> _write_descriptor{};
 
-                VkDescriptorBufferInfo _last_storage_buffer_info = _getDescriptorBufferInfo(&storage[(i - 1) % MAX_FRAMES_IN_FLIGHT].buffer, sizeof(Particle) * MAX_PARTICLES);
-                _write_descriptor[1] = _getStorageDescriptorWrite(&compute_descriptor.sets[i], &_last_storage_buffer_info, 1);
+                VkDescriptorBufferInfo _last_storage_buffer_info = _getDescriptorBufferInfo(&storage[(i - 1) % MAX_FRAMES_IN_FLIGHT].buffer, sizeof(Particle) * config.particle_count);
+                _write_descriptor[0] = _getStorageDescriptorWrite(&compute_descriptor.sets[i], &_last_storage_buffer_info, 0);
 
-                VkDescriptorBufferInfo _current_storage_buffer_info = _getDescriptorBufferInfo(&storage[i].buffer, sizeof(Particle) * MAX_PARTICLES);
-                _write_descriptor[2] = _getStorageDescriptorWrite(&compute_descriptor.sets[i], &_current_storage_buffer_info, 2);
+                VkDescriptorBufferInfo _current_storage_buffer_info = _getDescriptorBufferInfo(&storage[i].buffer, sizeof(Particle) * config.particle_count);
+                _write_descriptor[1] = _getStorageDescriptorWrite(&compute_descriptor.sets[i], &_current_storage_buffer_info, 1);
 
                 vkUpdateDescriptorSets(logical_device, static_cast<uint32_t>(_write_descriptor.size()), _write_descriptor.data(), 0, nullptr);
             }
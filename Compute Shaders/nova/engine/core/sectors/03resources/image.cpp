@@ -91,12 +91,14 @@ inline void NovaCore::copyBufferToImage(VkBuffer& buffer, VkImage& image, uint32
 static inline void destroyImage(VkDevice& device, const VkImage& image, const VkDeviceMemory& memory) 
     {
         if (image != VK_NULL_HANDLE) {
-            vkDestroyImage(device, image, nullptr);
+            RELEASE_OBJECT(VK_OBJECT_TYPE_IMAGE, image);
+            vkDestroyImage(device, image, HOST_ALLOCATOR);
             report(LOGGER::VLINE, "\t .. Destroying Image ..");
         }
 
         if (memory != VK_NULL_HANDLE) {
-            vkFreeMemory(device, memory, nullptr);
+            RELEASE_OBJECT(VK_OBJECT_TYPE_DEVICE_MEMORY, memory);
+            vkFreeMemory(device, memory, HOST_ALLOCATOR);
             report(LOGGER::VLINE, "\t .. Freeing Memory ..");
         }
     }
@@ -108,13 +110,15 @@ void NovaCore::createImage(uint32_t w, uint32_t h, uint32_t mips, VkSampleCountF
         report(LOGGER::VLINE, "\t\t .. Creating Image ..");
 
         VkImageCreateInfo _image_info = _createImageInfo(w, h, format, tiling, usage, mips, samples);
-        VK_TRY(vkCreateImage(logical_device, &_image_info, nullptr, &image));
+        VK_TRY(vkCreateImage(logical_device, &_image_info, HOST_ALLOCATOR, &image));
 
         VkMemoryRequirements _mem_reqs;
         vkGetImageMemoryRequirements(logical_device, image, &_mem_reqs);
+        REGISTER_OBJECT(VK_OBJECT_TYPE_IMAGE, image, _mem_reqs.size);
 
         VkMemoryAllocateInfo _alloc_info = getMemoryAllocateInfo(_mem_reqs, props);
-        VK_TRY(vkAllocateMemory(logical_device, &_alloc_info, nullptr, &memory));
+        VK_TRY(vkAllocateMemory(logical_device, &_alloc_info, HOST_ALLOCATOR, &memory));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_DEVICE_MEMORY, memory, _alloc_info.allocationSize);
         VK_TRY(vkBindImageMemory(logical_device, image, memory, 0));
 
         queues.deletion.push_fn([=]() { destroyImage(logical_device, image, memory); });
@@ -193,8 +197,12 @@ void NovaCore::createTextureImageView()
         report(LOGGER::VLINE, "\t .. Creating Texture Image View ..");
 
         VkImageViewCreateInfo _view_info = _getImageViewInfo(texture.image, _SRGB_FORMAT_888);
-        VK_TRY(vkCreateImageView(logical_device, &_view_info, nullptr, &texture.view));
-        queues.deletion.push_fn([=]() { vkDestroyImageView(logical_device, texture.view, nullptr); });
+        VK_TRY(vkCreateImageView(logical_device, &_view_info, HOST_ALLOCATOR, &texture.view));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_IMAGE_VIEW, texture.view, 0);
+        queues.deletion.push_fn([=]() { 
+                RELEASE_OBJECT(VK_OBJECT_TYPE_IMAGE_VIEW, texture.view);
+                vkDestroyImageView(logical_device, texture.view, HOST_ALLOCATOR); 
+            });
     }
 
 
@@ -232,14 +240,17 @@ void NovaCore::constructTextureSampler() {
     vkGetPhysicalDeviceProperties(physical_device, &_props);
     VkSamplerCreateInfo _sampler_info = _getSamplerInfo(_props, static_cast<float>(mip_lvls));
 
-    VK_TRY(vkCreateSampler(logical_device, &_sampler_info, nullptr, &texture.sampler));
+    VK_TRY(vkCreateSampler(logical_device, &_sampler_info, HOST_ALLOCATOR, &texture.sampler));
+    REGISTER_OBJECT(VK_OBJECT_TYPE_SAMPLER, texture.sampler, 0);
 
     queues.deletion.push_fn([=]() { 
         report(LOGGER::VLINE, "\t .. Destroying Texture Sampler ..");
-        vkDestroySampler(logical_device, texture.sampler, nullptr); });
+        RELEASE_OBJECT(VK_OBJECT_TYPE_SAMPLER, texture.sampler);
+        vkDestroySampler(logical_device, texture.sampler, HOST_ALLOCATOR); });
     queues.deletion.push_fn([=]() { 
         report(LOGGER::VLINE, "\t .. Destroying Texture Image View ..");
-        vkDestroyImageView(logical_device, texture.view, nullptr); });
+        RELEASE_OBJECT(VK_OBJECT_TYPE_IMAGE_VIEW, texture.view);
+        vkDestroyImageView(logical_device, texture.view, HOST_ALLOCATOR); });
 }
 
 
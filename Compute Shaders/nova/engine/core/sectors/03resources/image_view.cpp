@@ -7,10 +7,12 @@ VkImageView NovaCore::createImageView(VkImage image, VkFormat format, VkImageAsp
 
         VkImageViewCreateInfo _view_info = createImageViewInfo(image, format, aspect, 1);
         VkImageView view;
-        VK_TRY(vkCreateImageView(logical_device, &_view_info, nullptr, &view));
+        VK_TRY(vkCreateImageView(logical_device, &_view_info, HOST_ALLOCATOR, &view));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_IMAGE_VIEW, view, 0);
 
         queues.deletion.push_fn([=]() { 
-                vkDestroyImageView(logical_device, view, nullptr); 
+                RELEASE_OBJECT(VK_OBJECT_TYPE_IMAGE_VIEW, view);
+                vkDestroyImageView(logical_device, view, HOST_ALLOCATOR); 
                 report(LOGGER::VLINE, "\t .. Image View Destroyed ..");
             });
 
@@ -43,6 +45,8 @@ VkImageViewCreateInfo NovaCore::createImageViewInfo(VkImage img, VkFormat fmt, V
 
 void NovaCore::constructImageViews()
     {
+        STARTUP_STAGE();
+
         report(LOGGER::VLINE, "\t .. Constructing Image Views ..");
 
         swapchain.image_views.resize(swapchain.images.size());
@@ -50,7 +54,8 @@ void NovaCore::constructImageViews()
         for (size_t i = 0; i < swapchain.images.size(); i++) 
             {
                 VkImageViewCreateInfo _create_info = createImageViewInfo(swapchain.images[i], swapchain.details.surface.format, VK_IMAGE_ASPECT_COLOR_BIT, 1);
-                VK_TRY(vkCreateImageView(logical_device, &_create_info, nullptr, &swapchain.image_views[i]));
+                VK_TRY(vkCreateImageView(logical_device, &_create_info, HOST_ALLOCATOR, &swapchain.image_views[i]));
+                REGISTER_OBJECT(VK_OBJECT_TYPE_IMAGE_VIEW, swapchain.image_views[i], 0);
             }
 
         report(LOGGER::VLINE, "\t .. Image Views Constructed ..");
@@ -1,4 +1,5 @@
 #include "../../core.h"
+#include "../00atomic/genesis.h"
 
     ///////////////////////////
     // PIPELINE CONSTRUCTION //
@@ -6,34 +7,84 @@
 
 void NovaCore::constructGraphicsPipeline()
     { 
+        STARTUP_STAGE();
+
         report(LOGGER::DEBUG, "Management - Constructing Graphics Pipeline .."); 
         
         graphics_pipeline = new GraphicsPipeline();
 
-        graphics_pipeline->shaders(&logical_device)
+        graphics_pipeline->shaders(vert_shader, frag_shader)
                 .vertexInput()
                 .inputAssembly()
                 .viewportState()
                 .rasterizer()
                 .multisampling(msaa_samples)
                 .colorBlending()
-                .dynamicState()
-                .createLayout(&logical_device, &descriptor.layout)
-                .pipe(&render_pass)
-                .create(&logical_device);
+                .dynamicState(config.dynamic_state_level)
+                .pushConstants<ParticleDrawPush>(VK_SHADER_STAGE_VERTEX_BIT)
+                .createLayout(&logical_device, &descriptor.layout);
+
+        if (config.dynamic_rendering)
+            { graphics_pipeline->pipe(swapchain.details.surface.format); }
+        else
+            { graphics_pipeline->pipe(&render_pass); }
+
+        pipelines.acquire(&logical_device, graphics_pipeline);
 
         return; 
     }
     
+// The color format is baked into the graphics pipelines, and into the render pass without dynamic
+// rendering, so a swapchain that came back in a different format (an HDR/SDR switch) needs them rebuilt
+void NovaCore::rebuildForSurfaceFormat()
+    {
+        report(LOGGER::INFO, "Presentation - Surface Format Changed to %s, Rebuilding Pipelines ..", string_VkFormat(swapchain.details.surface.format));
+
+        VK_TRY(vkDeviceWaitIdle(logical_device));
+
+        bool _hud = hud_pipeline != nullptr;
+        destroyPipeline(graphics_pipeline);
+        if (_hud) { destroyPipeline(hud_pipeline); }
+
+        if (!config.dynamic_rendering)
+            {
+                RELEASE_OBJECT(VK_OBJECT_TYPE_RENDER_PASS, render_pass);
+                PipelineDescriptions::get().forgetRenderPass(render_pass);
+                vkDestroyRenderPass(logical_device, render_pass, HOST_ALLOCATOR);
+                createRenderPass();
+            }
+
+        constructGraphicsPipeline();
+        if (_hud) { constructHudPipeline(); }
+
+        return;
+    }
+
 void NovaCore::constructComputePipeline()
     { 
+        STARTUP_STAGE();
+
         report(LOGGER::DEBUG, "Management - Constructing Compute Pipeline .."); 
 
         compute_pipeline = new ComputePipeline();
 
-        compute_pipeline->shaders(&logical_device)
-                .createLayout(&logical_device, &compute_descriptor.layout)
-                .create(&logical_device);
+        if (config.binding_backend == BINDING_BINDLESS)
+            {
+                compute_pipeline->shaders(bindless_comp_shader)
+                        .workgroupSize(config.workgroup_size)
+                        .pushConstants<BindlessParticlePush>()
+                        .createLayout(&logical_device, &bindless.layout);
+            }
+        else
+            {
+                compute_pipeline->shaders(comp_shader)
+                        .workgroupSize(config.workgroup_size)
+                        .pushConstants<SimulationParams>()
+                        .flags(binder.pipelineFlags())
+                        .createLayout(&logical_device, &compute_descriptor.layout);
+            }
+
+        pipelines.acquire(&logical_device, compute_pipeline);
         
         return; 
     }
@@ -18,7 +18,7 @@ VkAttachmentDescription NovaCore::getColorAttachment()
             .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
             .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
             .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-            .finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+            .finalLayout = getTargetLayout()
         };
     }
 
@@ -172,6 +172,20 @@ static inline VkSubpassDependency _getDependency()
         };
     }
 
+// A headless target ends the pass in TRANSFER_SRC_OPTIMAL, the implicit dependency out of the
+// pass waits on nothing, so the readback's copy needs the color writes made visible to it here
+static inline VkSubpassDependency _getReadbackDependency()
+    {
+        return {
+            .srcSubpass = 0,
+            .dstSubpass = VK_SUBPASS_EXTERNAL,
+            .srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+            .dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
+            .srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT,
+        };
+    }
+
 static inline VkRenderPassCreateInfo _getRenderPassInfo(std::vector<VkAttachmentDescription>* attachments, VkSubpassDescription* subpass_description, VkSubpassDependency* dependency)
     {
         report(LOGGER::VLINE, "\t\t .. Getting Render Pass Create Info ..");
@@ -187,8 +201,13 @@ static inline VkRenderPassCreateInfo _getRenderPassInfo(std::vector<VkAttachment
 
 void NovaCore::createRenderPass()
     {
+        STARTUP_STAGE();
+
         report(LOGGER::VLINE, "\t .. Creating Render Pass ..");
 
+        if (config.dynamic_rendering)
+            { report(LOGGER::VLINE, "\t\t .. Dynamic Rendering, No Render Pass Needed .."); return; }
+
         //log();
         VkAttachmentDescription _color_attachment = getColorAttachment();
         //VkAttachmentDescription _depth_attachment = getDepthAttachment();
@@ -202,7 +221,7 @@ void NovaCore::createRenderPass()
             .colorAttachmentCount = 1,
             .pColorAttachments = &_color_attachment_ref,
         };
-        VkSubpassDependency _dependency = _getDependency();
+        VkSubpassDependency _dependencies[] = { _getDependency(), _getReadbackDependency() };
 
         // This is useful when mipmapping
         //std::array<VkAttachmentDescription, 3> _attachments = {_color_attachment, _depth_attachment, _color_resolve};
@@ -214,11 +233,13 @@ void NovaCore::createRenderPass()
             .pAttachments = &_color_attachment,
             .subpassCount = 1,
             .pSubpasses = &_subpass_description,
-            .dependencyCount = 1,
-            .pDependencies = &_dependency
+            .dependencyCount = config.headless ? 2u : 1u,
+            .pDependencies = _dependencies
         };
         
-        VK_TRY(vkCreateRenderPass(logical_device, &render_pass_info, nullptr, &render_pass));
+        VK_TRY(vkCreateRenderPass(logical_device, &render_pass_info, HOST_ALLOCATOR, &render_pass));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_RENDER_PASS, render_pass, 0);
+        PipelineDescriptions::get().describeRenderPass(render_pass, render_pass_info);
         return;
     }
 
@@ -239,3 +260,103 @@ VkRenderPassBeginInfo NovaCore::getRenderPassInfo(size_t i)
                 .pClearValues = &CLEAR_COLOR // CLEAR_VALUES.data()
             };
     }
+
+
+    ///////////////////////
+    // DYNAMIC RENDERING //
+    ///////////////////////
+
+void NovaCore::recordImageBarrier(VkCommandBuffer& command_buffer, VkImage image, VkImageLayout old_layout, VkImageLayout new_layout, 
+                                    VkPipelineStageFlags src_stage, VkAccessFlags src_access, VkPipelineStageFlags dst_stage, VkAccessFlags dst_access)
+    {
+        VkImageMemoryBarrier _barrier = getMemoryBarrier(image, old_layout, new_layout);
+        _barrier.srcAccessMask = src_access;
+        _barrier.dstAccessMask = dst_access;
+
+        vkCmdPipelineBarrier(command_buffer, src_stage, dst_stage, 0, 0, nullptr, 0, nullptr, 1, &_barrier);
+    }
+
+static inline VkRenderingAttachmentInfo _getColorAttachmentInfo(VkImageView view, const VkClearValue& clear)
+    {
+        return {
+            .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+            .pNext = nullptr,
+            .imageView = view,
+            .imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+            .resolveMode = VK_RESOLVE_MODE_NONE,
+            .resolveImageView = VK_NULL_HANDLE,
+            .resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+            .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+            .clearValue = clear
+        };
+    }
+
+// Opens the frame's color target, either through the render pass and framebuffer or with vkCmdBeginRendering
+void NovaCore::beginRendering(VkCommandBuffer& command_buffer, uint32_t i)
+    {
+        if (!config.dynamic_rendering)
+            {
+                VkRenderPassBeginInfo _render_pass_info = getRenderPassInfo(i);
+                vkCmdBeginRenderPass(command_buffer, &_render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
+                return;
+            }
+
+        // Under dynamic resolution the scene goes to this frame's render target and is blitted over later
+        VkImage _image = config.dynamic_resolution ? render_targets[_frame_ct].image : swapchain.images[i];
+        VkImageView _view = config.dynamic_resolution ? render_targets[_frame_ct].view : swapchain.image_views[i];
+
+        recordImageBarrier(command_buffer, _image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0, 
+                            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+
+        VkRenderingAttachmentInfo _color_attachment = _getColorAttachmentInfo(_view, CLEAR_COLOR);
+
+        VkRenderingInfo _rendering_info = {
+                .sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
+                .pNext = nullptr,
+                .flags = 0,
+                .renderArea = {
+                    .offset = {0, 0},
+                    .extent = renderExtent()
+                },
+                .layerCount = 1,
+                .viewMask = 0,
+                .colorAttachmentCount = 1,
+                .pColorAttachments = &_color_attachment,
+                .pDepthAttachment = nullptr,
+                .pStencilAttachment = nullptr
+            };
+
+        vkCmdBeginRendering(command_buffer, &_rendering_info);
+    }
+
+void NovaCore::endRendering(VkCommandBuffer& command_buffer, uint32_t i)
+    {
+        if (!config.dynamic_rendering)
+            {
+                vkCmdEndRenderPass(command_buffer);
+                return;
+            }
+
+        vkCmdEndRendering(command_buffer);
+
+        if (config.dynamic_resolution)
+            {
+                recordUpscale(command_buffer, i);
+                return;
+            }
+
+        // Headless targets are copied out next, not presented
+        if (config.headless)
+            {
+                recordImageBarrier(command_buffer, swapchain.images[i], VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, getTargetLayout(),
+                                    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, 
+                                    VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+                return;
+            }
+
+        recordImageBarrier(command_buffer, swapchain.images[i], VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, 
+                            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0);
+    }
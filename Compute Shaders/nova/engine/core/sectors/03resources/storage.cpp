@@ -6,23 +6,38 @@
 
 
 
+// Host side only, so it can run before there's a device to upload to
+void NovaCore::generateParticles()
+    {
+        STARTUP_STAGE();
+
+        report(LOGGER::DEBUG, "Management - Generating Particles ..");
+
+        particles.clear();
+        particles.reserve(config.particle_count);
+        genesis::createParticles(&particles, config.particle_count);
+
+        return;
+    }
+
 void NovaCore::constructStorageBuffers()
     {
+        STARTUP_STAGE();
+
         report(LOGGER::DEBUG, "Management - Constructing Storage Buffers ..");
 
-        // Initialize Particle Systems
-        std::vector<Particle> _particles(MAX_PARTICLES);
-        genesis::createParticles(&_particles);
+        if (particles.size() != config.particle_count) { generateParticles(); }
         
         // Create the Buffer
-        VkDeviceSize bufferSize = sizeof(Particle) * MAX_PARTICLES;
+        particle_capacity = config.particle_count;
+        VkDeviceSize bufferSize = sizeof(Particle) * particle_capacity;
         BufferContext stagingBuffer;
         createBuffer(bufferSize, _TRANSFER_SRC_BIT, _STAGING_PROPERTIES_BIT, &stagingBuffer);
 
         // Map the Buffer
         void* data;
         vkMapMemory(logical_device, stagingBuffer.memory, 0, bufferSize, 0, &data);
-        memcpy(data, _particles.data(), (size_t) bufferSize);
+        memcpy(data, particles.data(), (size_t) bufferSize);
         vkUnmapMemory(logical_device, stagingBuffer.memory);
 
         // Create the Buffer
@@ -30,12 +45,14 @@ void NovaCore::constructStorageBuffers()
 
         for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
             {
-                createBuffer(bufferSize, _STORAGE_BUFFER_BIT, _LOCAL_DEVICE_BIT, &storage[i]);
+                createBuffer(bufferSize, _STORAGE_BUFFER_BIT | binder.bufferUsage(), _LOCAL_DEVICE_BIT, &storage[i]);
                 copyBuffer(stagingBuffer.buffer, storage[i].buffer, bufferSize, queues.transfer.queue, queues.transfer.pool); // TODO: We need to try and use Compute to acheive async and implement transfer queue
             }
 
         // Clean Up
         destroyBuffer(&stagingBuffer);
+        particles.clear();
+        particles.shrink_to_fit();
         
         return;
     }
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include "../../core.h"
+
+#include <algorithm>
+
+
+    //////////////////
+    // CAPTURE RING //
+    //////////////////
+
+static inline bool _isCapturable(VkFormat format)
+    {
+        switch (format)
+            {
+                case VK_FORMAT_B8G8R8A8_UNORM:
+                case VK_FORMAT_B8G8R8A8_SRGB:
+                case VK_FORMAT_R8G8B8A8_UNORM:
+                case VK_FORMAT_R8G8B8A8_SRGB: return true;
+                default: return false;
+            }
+    }
+
+static inline bool _isBGRA(VkFormat format)
+    { return format == VK_FORMAT_B8G8R8A8_UNORM || format == VK_FORMAT_B8G8R8A8_SRGB; }
+
+// Host cached memory makes the writer's reads cheap, plain host visible is the fallback
+static inline VkMemoryPropertyFlags _getReadbackProperties(VkPhysicalDevice physical_device)
+    {
+        VkPhysicalDeviceMemoryProperties _mem_props;
+        vkGetPhysicalDeviceMemoryProperties(physical_device, &_mem_props);
+
+        const VkMemoryPropertyFlags _CACHED = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+
+        for (uint32_t i = 0; i < _mem_props.memoryTypeCount; i++)
+            { if ((_mem_props.memoryTypes[i].propertyFlags & _CACHED) == _CACHED) { return _CACHED; } }
+
+        return VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    }
+
+// Readback buffers are sized on first use, so the ring costs nothing until a frame is captured
+void NovaCore::createCaptureRing()
+    {
+        STARTUP_STAGE();
+
+        if (config.capture_interval == 0) { return; }
+
+        report(LOGGER::VLINE, "\t .. Creating Capture Ring ..");
+
+        if (!_isCapturable(swapchain.details.surface.format))
+            {
+                report(LOGGER::INFO, "NovaCore - Can't Capture %s, Capture Disabled ..", string_VkFormat(swapchain.details.surface.format));
+                config.capture_interval = 0;
+                return;
+            }
+
+        capture_writer.start(config.capture_format, config.capture_path, std::max(1u, 60u / config.capture_interval));
+
+        return;
+    }
+
+// Copies the frame's target into the next ring slot. A slot the writer hasn't finished with
+// means the capture is dropped, rendering never waits on the disk.
+void NovaCore::recordCapture(VkCommandBuffer& command_buffer, uint32_t i)
+    {
+        if (config.capture_interval == 0 || frame_number % config.capture_interval != 0) { return; }
+
+        CaptureSlot& _slot = captures[capture_cursor];
+
+        if (!_slot.free.load(std::memory_order_acquire))
+            { capture_writer.dropped.fetch_add(1, std::memory_order_relaxed); return; }
+
+        VkExtent2D _extent = swapchain.details.extent;
+        VkDeviceSize _size = (VkDeviceSize)_extent.width * _extent.height * 4;
+
+        // Free means neither the GPU nor the writer still holds it, so it can be regrown
+        if (_slot.size < _size)
+            {
+                if (_slot.mapped != nullptr)
+                    {
+                        vkUnmapMemory(logical_device, _slot.buffer.memory);
+                        destroyBuffer(&_slot.buffer);
+                    }
+
+                createBuffer(_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, _getReadbackProperties(physical_device), &_slot.buffer);
+                VK_TRY(vkMapMemory(logical_device, _slot.buffer.memory, 0, VK_WHOLE_SIZE, 0, &_slot.mapped));
+                _slot.size = _size;
+            }
+
+        VkImageLayout _target_layout = getTargetLayout();
+
+        // The last write was either the render or the dynamic resolution blit. Recorded even when a
+        // headless target is already in TRANSFER_SRC_OPTIMAL, so the copy never relies on whatever
+        // moved it there having made those writes visible.
+        recordImageBarrier(command_buffer, swapchain.images[i], _target_layout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+                            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+
+        VkBufferImageCopy _region = {
+                .bufferOffset = 0,
+                .bufferRowLength = 0,
+                .bufferImageHeight = 0,
+                .imageSubresource = {
+                    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .mipLevel = 0,
+                    .baseArrayLayer = 0,
+                    .layerCount = 1
+                },
+                .imageOffset = { 0, 0, 0 },
+                .imageExtent = { _extent.width, _extent.height, 1 }
+            };
+
+        vkCmdCopyImageToBuffer(command_buffer, swapchain.images[i], VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, _slot.buffer.buffer, 1, &_region);
+
+        VkBufferMemoryBarrier _host_barrier = {
+                .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+                .pNext = nullptr,
+                .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                .dstAccessMask = VK_ACCESS_HOST_READ_BIT,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .buffer = _slot.buffer.buffer,
+                .offset = 0,
+                .size = VK_WHOLE_SIZE
+            };
+
+        vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &_host_barrier, 0, nullptr);
+
+        if (_target_layout != VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL)
+            {
+                recordImageBarrier(command_buffer, swapchain.images[i], VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, _target_layout,
+                                    VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                                    VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0);
+            }
+
+        _slot.free.store(false, std::memory_order_relaxed);
+        _slot.pending = true;
+        _slot.frame = frame_number;
+        _slot.extent = _extent;
+        capture_cursor = (capture_cursor + 1) % CAPTURE_RING_SIZE;
+
+        return;
+    }
+
+// Called after the frame fences are waited on: a capture from frame_number - MAX_FRAMES_IN_FLIGHT
+// or earlier has landed. all hands over everything, for teardown once the device is idle.
+void NovaCore::collectCaptures(bool all)
+    {
+        for (auto& _slot : captures)
+            {
+                if (!_slot.pending || (!all && _slot.frame + MAX_FRAMES_IN_FLIGHT > frame_number)) { continue; }
+
+                VkMappedMemoryRange _range = {
+                        .sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
+                        .pNext = nullptr,
+                        .memory = _slot.buffer.memory,
+                        .offset = 0,
+                        .size = VK_WHOLE_SIZE
+                    };
+
+                VK_TRY(vkInvalidateMappedMemoryRanges(logical_device, 1, &_range));
+
+                _slot.pending = false;
+                capture_writer.submit({
+                        .pixels = static_cast<const uint8_t*>(_slot.mapped),
+                        .width = _slot.extent.width,
+                        .height = _slot.extent.height,
+                        .frame = _slot.frame,
+                        .bgra = _isBGRA(swapchain.details.surface.format),
+                        .done = &_slot.free
+                    });
+            }
+
+        return;
+    }
+
+void NovaCore::destroyCaptureRing()
+    {
+        if (!capture_writer.running()) { return; }
+
+        report(LOGGER::VLINE, "\t .. Destroying Capture Ring ..");
+
+        collectCaptures(true);
+        capture_writer.stop();
+
+        for (auto& _slot : captures)
+            {
+                if (_slot.mapped == nullptr) { continue; }
+
+                vkUnmapMemory(logical_device, _slot.buffer.memory);
+                destroyBuffer(&_slot.buffer);
+                _slot.mapped = nullptr;
+                _slot.size = 0;
+            }
+
+        return;
+    }
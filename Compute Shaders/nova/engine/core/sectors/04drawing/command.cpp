@@ -1,5 +1,7 @@
 #include "../../core.h"
 
+#include <array>
+
 
     /////////////////////
     // COMMAND BUFFERS //
@@ -28,26 +30,31 @@ static inline VkCommandPoolCreateInfo _createCommandPoolInfo(unsigned int queue_
     
 void NovaCore::createCommandPool() 
     {
+        STARTUP_STAGE();
+
         report(LOGGER::VLINE, "\t .. Creating Command Pool ..");
 
         {
             char name[] = "Graphics";
             VkCommandPoolCreateInfo _gfx_cmd_pool_create_info = _createCommandPoolInfo(queues.indices.graphics_family.value(), name);
 
-            VK_TRY(vkCreateCommandPool(logical_device, &_gfx_cmd_pool_create_info, nullptr, &queues.command_pool));
+            VK_TRY(vkCreateCommandPool(logical_device, &_gfx_cmd_pool_create_info, HOST_ALLOCATOR, &queues.command_pool));
+            REGISTER_OBJECT(VK_OBJECT_TYPE_COMMAND_POOL, queues.command_pool, 0);
         }
 
 
         {
             char name[] = "Transfer";
             VkCommandPoolCreateInfo _xfr_cmd_pool_create_info = _createCommandPoolInfo(queues.indices.transfer_family.value(), name);
-            VK_TRY(vkCreateCommandPool(logical_device, &_xfr_cmd_pool_create_info, nullptr, &queues.transfer.pool));
+            VK_TRY(vkCreateCommandPool(logical_device, &_xfr_cmd_pool_create_info, HOST_ALLOCATOR, &queues.transfer.pool));
+            REGISTER_OBJECT(VK_OBJECT_TYPE_COMMAND_POOL, queues.transfer.pool, 0);
         }
 
         {
             char name[] = "Compute";
             VkCommandPoolCreateInfo _cmp_cmd_pool_create_info = _createCommandPoolInfo(queues.indices.compute_family.value(), name);
-            VK_TRY(vkCreateCommandPool(logical_device, &_cmp_cmd_pool_create_info, nullptr, &queues.compute.pool));
+            VK_TRY(vkCreateCommandPool(logical_device, &_cmp_cmd_pool_create_info, HOST_ALLOCATOR, &queues.compute.pool));
+            REGISTER_OBJECT(VK_OBJECT_TYPE_COMMAND_POOL, queues.compute.pool, 0);
         }
 
         return;
@@ -68,6 +75,8 @@ inline VkCommandBufferAllocateInfo NovaCore::createCommandBuffersInfo(VkCommandP
 
 void NovaCore::createCommandBuffers() 
     {
+        STARTUP_STAGE();
+
         report(LOGGER::VLINE, "\t .. Creating Command Buffers ..");
 
         for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
@@ -168,29 +177,53 @@ void NovaCore::recordCommandBuffers(VkCommandBuffer& command_buffer, uint32_t i)
 
         VkCommandBufferBeginInfo _begin_info = createBeginInfo();
         VK_TRY(vkBeginCommandBuffer(command_buffer, &_begin_info));
+        uint32_t _family = queues.indices.graphics_family.value();
+        uint32_t _graphics_scope = gpu_profiler.begin(command_buffer, _frame_ct, _family, "Graphics");
+        uint32_t _render_scope = gpu_profiler.begin(command_buffer, _frame_ct, _family, "Render");
+        pipeline_statistics.reset(command_buffer, _frame_ct, QUERY_GRAPHICS);
 
-        VkRenderPassBeginInfo _render_pass_info = getRenderPassInfo(i);
-        vkCmdBeginRenderPass(command_buffer, &_render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
+        beginRendering(command_buffer, i);
+        pipeline_statistics.begin(command_buffer, _frame_ct, QUERY_GRAPHICS);
 
         vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphics_pipeline->instance);
 
-        VkViewport _viewport = getViewport(swapchain.details.extent);
+        VkViewport _viewport = getViewport(renderExtent());
         vkCmdSetViewport(command_buffer, 0, 1, &_viewport);
 
-        VkRect2D _scissor = getScissor(swapchain.details.extent);
+        VkRect2D _scissor = getScissor(renderExtent());
         vkCmdSetScissor(command_buffer, 0, 1, &_scissor);
 
-        //VkBuffer _vertex_buffers[] = {vertex.buffer};
-        VkDeviceSize _offsets[] = {0};
-        vkCmdBindVertexBuffers(command_buffer, 0, 1, &storage[_frame_ct].buffer, _offsets);
+        recordRenderState(command_buffer);
+
+        // The particles are both bindings, points read the per vertex one and quads the per instance one
+        VkBuffer _vertex_buffers[] = { storage[_frame_ct].buffer, storage[_frame_ct].buffer };
+        VkDeviceSize _offsets[] = { 0, 0 };
+        vkCmdBindVertexBuffers(command_buffer, 0, 2, _vertex_buffers, _offsets);
         //vkCmdBindIndexBuffer(command_buffer, index.buffer, 0, VK_INDEX_TYPE_UINT32);
         //vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphics_pipeline->layout, 0, 1, &descriptor.sets[_frame_ct], 0, nullptr);
 
+        // Quads are as wide as the four pixel point sprites
+        VkExtent2D _extent = renderExtent();
+        bool _quads = render_state.topology == VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        ParticleDrawPush _draw_push = {
+                .quad_size = { 8.0f / _extent.width, 8.0f / _extent.height },
+                .quads = _quads ? 1u : 0u
+            };
+        graphics_pipeline->push(command_buffer, _draw_push);
+
         //vkCmdDrawIndexed(command_buffer, static_cast<uint32_t>(graphics_pipeline->indices.size()), 1, 0, 0, 0);
-        vkCmdDraw(command_buffer, MAX_PARTICLES, 1, 0, 0);
+        if (_quads) { vkCmdDraw(command_buffer, 6, config.particle_count, 0, 0); }
+        else { vkCmdDraw(command_buffer, config.particle_count, 1, 0, 0); }
+
+        // The query began and ends in this subpass, so the HUD's quads stay out of the particle counts
+        pipeline_statistics.end(command_buffer, _frame_ct, QUERY_GRAPHICS);
+        recordHud(command_buffer);
 
-        vkCmdEndRenderPass(command_buffer);
+        endRendering(command_buffer, i);
+        gpu_profiler.end(command_buffer, _frame_ct, _render_scope);
+        recordCapture(command_buffer, i);
 
+        gpu_profiler.end(command_buffer, _frame_ct, _graphics_scope);
         VK_TRY(vkEndCommandBuffer(command_buffer));
 
         return;
@@ -202,12 +235,45 @@ void NovaCore::recordComputeCommandBuffer(VkCommandBuffer& command_buffer, uint3
 
         VkCommandBufferBeginInfo _begin_info = createBeginInfo();
         VK_TRY(vkBeginCommandBuffer(command_buffer, &_begin_info));
+        uint32_t _compute_scope = gpu_profiler.begin(command_buffer, i, queues.indices.compute_family.value(), "Compute");
+        pipeline_statistics.reset(command_buffer, i, QUERY_COMPUTE);
+        pipeline_statistics.begin(command_buffer, i, QUERY_COMPUTE);
 
         vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, compute_pipeline->instance);
-        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, compute_pipeline->layout, 0, 1, &compute_descriptor.sets[i], 0, nullptr);
-        vkCmdDispatch(command_buffer, MAX_PARTICLES / 2560, 16, 1); 
-        // TODO: Come up with a way of calculating this ^^ dynamically based on a number of verts or points
 
+        if (config.binding_backend == BINDING_BINDLESS)
+            {
+                BindlessParticlePush _push = {
+                        .particles_in = storage_slots[(i - 1) % MAX_FRAMES_IN_FLIGHT],
+                        .particles_out = storage_slots[i],
+                        .simulation = simulation
+                    };
+
+                vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, compute_pipeline->layout, 0, 1, &bindless.set, 0, nullptr);
+                compute_pipeline->push(command_buffer, _push);
+            }
+        else if (config.binding_backend == BINDING_DESCRIPTOR_SETS)
+            { 
+                vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, compute_pipeline->layout, 0, 1, &compute_descriptor.sets[i], 0, nullptr); 
+                compute_pipeline->push(command_buffer, simulation);
+            }
+        else
+            {
+                std::array<VkDescriptorBufferInfo, 2> _particles = {{
+                        { storage[(i - 1) % MAX_FRAMES_IN_FLIGHT].buffer, 0, sizeof(Particle) * config.particle_count },
+                        { storage[i].buffer, 0, sizeof(Particle) * config.particle_count }
+                    }};
+
+                binder.bindStorageBuffers(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, compute_pipeline->layout, compute_descriptor.layout, i,
+                        _particles.data(), static_cast<uint32_t>(_particles.size()));
+                compute_pipeline->push(command_buffer, simulation);
+            }
+
+        // One invocation per particle, the shader drops the overhang in the last group
+        vkCmdDispatch(command_buffer, (config.particle_count + config.workgroup_size - 1) / config.workgroup_size, 1, 1);
+
+        pipeline_statistics.end(command_buffer, i, QUERY_COMPUTE);
+        gpu_profiler.end(command_buffer, i, _compute_scope);
         VK_TRY(vkEndCommandBuffer(command_buffer));
     }
 
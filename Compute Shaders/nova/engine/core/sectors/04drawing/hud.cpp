@@ -0,0 +1,201 @@
+#include "../../core.h"
+#include "../00atomic/genesis.h"
+
+#include <algorithm>
+
+
+    /////////////////////
+    // PERFORMANCE HUD //
+    /////////////////////
+
+const float _HUD_SCALE = 2.0f;                                      // pixels per font cell
+const float _HUD_LINE = (HUD_GLYPH_HEIGHT + 2) * _HUD_SCALE;
+const float _HUD_MARGIN = 8.0f;
+const float _HUD_PADDING = 6.0f;
+const float _HUD_GRAPH_WIDTH = 240.0f;                              // two pixels per sample
+const float _HUD_GRAPH_HEIGHT = 40.0f;
+const float _HUD_REFERENCE_MS = 1000.0f / 60.0f;                    // graphs never scale below a 60 Hz frame
+const double _HUD_REFRESH = 0.25;                                   // seconds between text updates
+
+const uint32_t _HUD_BACKGROUND = hudColor(0, 0, 0, 160);
+const uint32_t _HUD_TEXT = hudColor(235, 235, 235);
+const uint32_t _HUD_CPU = hudColor(90, 220, 120);
+const uint32_t _HUD_GPU = hudColor(240, 160, 60);
+const uint32_t _HUD_REFERENCE = hudColor(255, 255, 255, 90);
+
+// Every quad is an instance of one six vertex draw, the vertex shader builds the corners itself
+static inline std::vector<VkVertexInputAttributeDescription> _getHudAttributes()
+    {
+        return {
+                { .location = 0, .binding = 0, .format = VK_FORMAT_R32G32B32A32_SFLOAT, .offset = offsetof(HudQuad, x) },
+                { .location = 1, .binding = 0, .format = VK_FORMAT_R32_UINT, .offset = offsetof(HudQuad, glyph) },
+                { .location = 2, .binding = 0, .format = VK_FORMAT_R32_UINT, .offset = offsetof(HudQuad, color) }
+            };
+    }
+
+// The overlay's buffers stay mapped, each frame's quads are written straight into the slot its fence just freed
+void NovaCore::createHud()
+    {
+        STARTUP_STAGE();
+
+        if (!config.hud) { return; }
+
+        report(LOGGER::DEBUG, "Management - Constructing HUD ..");
+
+        constructHudPipeline();
+
+        for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+            {
+                createBuffer(sizeof(HudQuad) * HUD_MAX_QUADS, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, _STAGING_PROPERTIES_BIT, &hud_quads[i]);
+                VK_TRY(vkMapMemory(logical_device, hud_quads[i].memory, 0, VK_WHOLE_SIZE, 0, (void**)&hud_mapped[i]));
+            }
+
+        return;
+    }
+
+// Separate from the buffers, a new surface format only needs the pipeline rebuilt
+void NovaCore::constructHudPipeline()
+    {
+        VkVertexInputBindingDescription _binding = {
+                .binding = 0,
+                .stride = sizeof(HudQuad),
+                .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE
+            };
+
+        hud_pipeline = new GraphicsPipeline();
+
+        hud_pipeline->shaders(hud_vert_shader, hud_frag_shader)
+                .vertexInput({ _binding }, _getHudAttributes())
+                .inputAssembly(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST)
+                .viewportState()
+                .rasterizer(VK_CULL_MODE_NONE)
+                .multisampling(msaa_samples)
+                .colorBlending()
+                .dynamicState()
+                .pushConstants<HudPush>(VK_SHADER_STAGE_VERTEX_BIT)
+                .createLayout(&logical_device, nullptr);
+
+        if (config.dynamic_rendering)
+            { hud_pipeline->pipe(swapchain.details.surface.format); }
+        else
+            { hud_pipeline->pipe(&render_pass); }
+
+        pipelines.acquire(&logical_device, hud_pipeline);
+
+        return;
+    }
+
+void NovaCore::toggleHud()
+    {
+        if (hud_pipeline == nullptr)
+            { report(LOGGER::INFO, "NovaCore - No HUD, Run With NOVA_HUD=1 .."); return; }
+
+        hud_visible = !hud_visible;
+
+        return;
+    }
+
+// Snprintf into fixed lines, so the text costs nothing between refreshes and never allocates
+void NovaCore::refreshHud()
+    {
+        double _now = frame_stats.seconds();
+        if (_now - hud_refreshed < _HUD_REFRESH) { return; }
+        hud_refreshed = _now;
+
+        double _graphics_ms = 0.0, _compute_ms = 0.0, _render_ms = 0.0;
+        gpu_profiler.sample("Graphics", &_graphics_ms);
+        gpu_profiler.sample("Compute", &_compute_ms);
+        gpu_profiler.sample("Render", &_render_ms);
+
+        double _device_mb = deviceMemoryMB();
+
+        snprintf(hud_lines[0], HUD_LINE_LENGTH, "FPS %.0f", last_frame_time > 0.0f ? 1.0f / last_frame_time : 0.0f);
+        snprintf(hud_lines[1], HUD_LINE_LENGTH, "CPU %.2f MS", last_frame_time * 1000.0f);
+        snprintf(hud_lines[2], HUD_LINE_LENGTH, "GPU %.2f MS", _graphics_ms);
+        snprintf(hud_lines[3], HUD_LINE_LENGTH, "  COMPUTE %.2f MS", _compute_ms);
+        snprintf(hud_lines[4], HUD_LINE_LENGTH, "  RENDER %.2f MS", _render_ms);
+        snprintf(hud_lines[5], HUD_LINE_LENGTH, "PARTICLES %u", config.particle_count);
+
+        if (_device_mb >= 0.0) { snprintf(hud_lines[6], HUD_LINE_LENGTH, "VRAM %.0f MB", _device_mb); }
+        else { snprintf(hud_lines[6], HUD_LINE_LENGTH, "VRAM N/A"); }
+
+        snprintf(hud_lines[7], HUD_LINE_LENGTH, "OBJECTS %llu", (unsigned long long)ObjectRegistry::get().live());
+
+        return;
+    }
+
+static inline void _drawHudGraph(HudCanvas& canvas, float x, float y, const char* label, HudSeries& series, uint32_t color)
+    {
+        canvas.text(x, y, _HUD_SCALE, _HUD_TEXT, label);
+        y += _HUD_LINE;
+
+        float _ceiling = std::max(series.max(), _HUD_REFERENCE_MS);
+        canvas.graph(x, y, _HUD_GRAPH_WIDTH, _HUD_GRAPH_HEIGHT, series, _ceiling, color);
+        canvas.rect(x, y + _HUD_GRAPH_HEIGHT * (1.0f - _HUD_REFERENCE_MS / _ceiling), _HUD_GRAPH_WIDTH, 1.0f, _HUD_REFERENCE);
+
+        return;
+    }
+
+// Lays the overlay out into this frame's buffer and draws all of it in one instanced call.
+// Recorded inside the particle pass, after the particles, so it lands on top of them.
+void NovaCore::recordHud(VkCommandBuffer& command_buffer)
+    {
+        if (hud_pipeline == nullptr || !hud_visible) { return; }
+
+        hud_cpu.push(last_frame_time * 1000.0f);
+
+        double _gpu_ms = 0.0;
+        gpu_profiler.sample("Graphics", &_gpu_ms);
+        hud_gpu.push(static_cast<float>(_gpu_ms));
+
+        refreshHud();
+
+        HudCanvas _canvas;
+        _canvas.begin(hud_mapped[_frame_ct], HUD_MAX_QUADS);
+
+        float _width = _HUD_GRAPH_WIDTH + 2 * _HUD_PADDING;
+        float _height = HUD_LINES * _HUD_LINE + 2 * (_HUD_LINE + _HUD_GRAPH_HEIGHT + _HUD_PADDING) + _HUD_PADDING;
+        _canvas.rect(_HUD_MARGIN, _HUD_MARGIN, _width, _height, _HUD_BACKGROUND);
+
+        float _x = _HUD_MARGIN + _HUD_PADDING;
+        float _y = _HUD_MARGIN + _HUD_PADDING;
+
+        for (uint32_t i = 0; i < HUD_LINES; i++, _y += _HUD_LINE)
+            { _canvas.text(_x, _y, _HUD_SCALE, _HUD_TEXT, hud_lines[i]); }
+
+        _y += _HUD_PADDING;
+        _drawHudGraph(_canvas, _x, _y, "CPU MS", hud_cpu, _HUD_CPU);
+
+        _y += _HUD_LINE + _HUD_GRAPH_HEIGHT + _HUD_PADDING;
+        _drawHudGraph(_canvas, _x, _y, "GPU MS", hud_gpu, _HUD_GPU);
+
+        VkExtent2D _extent = renderExtent();
+        HudPush _push = { .extent = { static_cast<float>(_extent.width), static_cast<float>(_extent.height) } };
+
+        VkDeviceSize _offsets[] = {0};
+        vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, hud_pipeline->instance);
+        vkCmdBindVertexBuffers(command_buffer, 0, 1, &hud_quads[_frame_ct].buffer, _offsets);
+        hud_pipeline->push(command_buffer, _push);
+        vkCmdDraw(command_buffer, 6, _canvas.count(), 0, 0);
+
+        return;
+    }
+
+void NovaCore::destroyHud()
+    {
+        if (hud_pipeline == nullptr) { return; }
+
+        report(LOGGER::VLINE, "\t .. Destroying HUD ..");
+
+        for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+            {
+                vkUnmapMemory(logical_device, hud_quads[i].memory);
+                destroyBuffer(&hud_quads[i]);
+                hud_mapped[i] = nullptr;
+            }
+
+        destroyPipeline(hud_pipeline);
+        hud_pipeline = nullptr;
+
+        return;
+    }
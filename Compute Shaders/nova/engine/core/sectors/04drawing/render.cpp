@@ -39,11 +39,11 @@ static inline VkCommandBufferSubmitInfo getCommandBufferSubmitInfo(VkCommandBuff
         };
     }
 
-static inline VkSubmitInfo getSubmitInfo(VkCommandBuffer* command_buffer, VkSemaphore* _signal_semaphore, VkSemaphore* _wait_semaphore, VkPipelineStageFlags* _wait_stages) 
+static inline VkSubmitInfo getSubmitInfo(VkCommandBuffer* command_buffer, VkSemaphore* _signal_semaphore, VkSemaphore* _wait_semaphore, VkPipelineStageFlags* _wait_stages, uint32_t _wait_count = 2) 
     {
         return {
             .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-            .waitSemaphoreCount = _wait_semaphore ? (uint32_t)2 : 0, // TODO: Need to add a count here
+            .waitSemaphoreCount = _wait_semaphore ? _wait_count : 0,
             .pWaitSemaphores = _wait_semaphore,
             .pWaitDstStageMask = _wait_stages,
             .commandBufferCount = 1,
@@ -60,16 +60,36 @@ static inline VkSubmitInfo getSubmitInfo(VkCommandBuffer* command_buffer, VkSema
 void NovaCore::drawFrame() 
     {
         //report(LOGGER::VLINE, "\t .. Drawing Frame %d ..", _frame_ct);
+        TraceRecorder::get().frame(frame_number);
+        ObjectRegistry::get().frame(frame_number);
+        TRACE_SCOPE("drawFrame");
+        HostFrameScope _host_frame;
 
         ///////////////////
         // Compute Queue //
         ///////////////////
 
-        VK_TRY(vkWaitForFences(logical_device, 1, &current_compute().in_flight, VK_TRUE, UINT64_MAX));
+        // Both of this slot's fences, so nothing from its last use still reads the queries and buffers reused below
+        VkFence _slot_fences[] = { current_compute().in_flight, current_frame().in_flight };
+        {
+            TRACE_SCOPE("vkWaitForFences");
+            FrameTimer _fence_timer(frame_stats, METRIC_FENCE_WAIT);
+            VK_TRY(vkWaitForFences(logical_device, 2, _slot_fences, VK_TRUE, UINT64_MAX));
+        }
         current_compute().deletion_queue.flush();
+        destroyRetiredSwapChains(false);
+        collectCaptures(false);
+        gpu_profiler.collect(_frame_ct);
+        pipeline_statistics.collect(_frame_ct);
 
-        // used to update the uniform buffer in the shader data update
-        updateUniformBuffer(_frame_ct);
+        double _gpu_ms;
+        if (gpu_profiler.sample("Graphics", &_gpu_ms))
+            { frame_stats.record(METRIC_GPU_FRAME, static_cast<uint64_t>(_gpu_ms * 1e6)); }
+
+        updateRenderScale();
+
+        // the simulation parameters are pushed with the dispatch, no buffer to update
+        updateSimulation();
 
         // reset the command buffer to begin recording the compute commands for the frame
         VK_TRY(vkResetFences(logical_device, 1, &current_compute().in_flight));
@@ -88,12 +108,20 @@ void NovaCore::drawFrame()
         // Graphics Queue //
         ////////////////////
 
-        VK_TRY(vkWaitForFences(logical_device, 1, &current_frame().in_flight, VK_TRUE, UINT64_MAX));
+        // The graphics fence was already waited on with the compute fence above
         //current_frame().deletion_queue.flush();
 
+        if (config.headless)
+            { drawOffscreen(); return; }
+
         //log();
         uint32_t _image_index;
-        VkResult result = vkAcquireNextImageKHR(
+        VkResult result;
+
+        {
+            TRACE_SCOPE("vkAcquireNextImageKHR");
+            FrameTimer _acquire_timer(frame_stats, METRIC_ACQUIRE);
+            result = vkAcquireNextImageKHR(
                             logical_device, 
                             swapchain.instance, 
                             UINT64_MAX, 
@@ -101,6 +129,7 @@ void NovaCore::drawFrame()
                             VK_NULL_HANDLE, 
                             &_image_index
                         );
+        }
 
         if (result == VK_ERROR_OUT_OF_DATE_KHR)
             { recreateSwapChain(); return; }
@@ -111,7 +140,10 @@ void NovaCore::drawFrame()
         VK_TRY(vkResetFences(logical_device, 1, &current_frame().in_flight));
         VK_TRY(vkResetCommandBuffer(current_frame().command_buffer, 0));
 
-        recordCommandBuffers(current_frame().command_buffer, _image_index);
+        {
+            TRACE_SCOPE("recordCommandBuffers");
+            recordCommandBuffers(current_frame().command_buffer, _image_index);
+        }
 
         // submit the command buffer to the graphics queue
         present.submit_info = {};
@@ -120,14 +152,21 @@ void NovaCore::drawFrame()
         VkPipelineStageFlags _wait_stages[] = { VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
         present.submit_info = getSubmitInfo(&current_frame().command_buffer, _signal_semaphores, _wait_semaphores, _wait_stages);
 
-        VK_TRY(vkQueueSubmit(queues.graphics, 1, &present.submit_info, current_frame().in_flight));
+        {
+            TRACE_SCOPE("vkQueueSubmit");
+            VK_TRY(vkQueueSubmit(queues.graphics, 1, &present.submit_info, current_frame().in_flight));
+        }
 
         // present the image to the screen
         VkSwapchainKHR _swapchains[] = { swapchain.instance };
         present.present_info = {};
         present.present_info = getPresentInfoKHR(_signal_semaphores, _swapchains, &_image_index);
 
-        result = vkQueuePresentKHR(queues.present, &present.present_info);
+        {
+            TRACE_SCOPE("vkQueuePresentKHR");
+            FrameTimer _present_timer(frame_stats, METRIC_PRESENT);
+            result = vkQueuePresentKHR(queues.present, &present.present_info);
+        }
 
         // check if the window was resized and recreate the swap chain if it was
         if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || framebuffer_resized)
@@ -141,7 +180,48 @@ void NovaCore::drawFrame()
                 VK_TRY(result);
             }
 
+        _endFrame();
+
+        return;
+    }
+
+// The graphics half of a headless frame. Each slot owns its target, so there's nothing to acquire,
+// and the only wait is on this frame's compute pass.
+void NovaCore::drawOffscreen()
+    {
+        TRACE_SCOPE("drawOffscreen");
+
+        VK_TRY(vkResetFences(logical_device, 1, &current_frame().in_flight));
+        VK_TRY(vkResetCommandBuffer(current_frame().command_buffer, 0));
+
+        recordCommandBuffers(current_frame().command_buffer, _frame_ct);
+
+        present.submit_info = {};
+        VkSemaphore _wait_semaphores[] = { current_compute().finished };
+        VkPipelineStageFlags _wait_stages[] = { VK_PIPELINE_STAGE_VERTEX_INPUT_BIT };
+        present.submit_info = getSubmitInfo(&current_frame().command_buffer, nullptr, _wait_semaphores, _wait_stages, 1);
+
+        VK_TRY(vkQueueSubmit(queues.graphics, 1, &present.submit_info, current_frame().in_flight));
+
+        _endFrame();
+
+        return;
+    }
+
+// Everything after the submit that a windowed and a headless frame have in common
+void NovaCore::_endFrame()
+    {
+        if (frame_number == 0)
+            {
+                StartupProfiler::get().finish(config.startup_report);
+                ObjectRegistry::get().mark();
+            }
+
+        if (config.bench_path != nullptr && frame_number == config.bench_warmup)
+            { startBenchmark(); }
+
         _frame_ct = (_frame_ct + 1) % MAX_FRAMES_IN_FLIGHT;
+        frame_number++;
 
         syncClock();
 
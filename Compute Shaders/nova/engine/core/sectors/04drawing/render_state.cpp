@@ -0,0 +1,149 @@
+#include "../../core.h"
+
+
+    ///////////////////////////
+    // DYNAMIC STATE LOADING //
+    ///////////////////////////
+
+// Resolves the core name on 1.3 devices and falls back to the EXT alias, both share a signature
+static inline PFN_vkVoidFunction _getCommand(VkDevice device, bool core, const char* core_name, const char* ext_name)
+    {
+        PFN_vkVoidFunction _command = core ? vkGetDeviceProcAddr(device, core_name) : nullptr;
+        return _command ? _command : vkGetDeviceProcAddr(device, ext_name);
+    }
+
+void NovaCore::loadDynamicStateCommands()
+    {
+        report(LOGGER::VLINE, "\t .. Loading Dynamic State Commands ..");
+
+        dynamic_state = {};
+        bool _core = device_properties.apiVersion >= VK_API_VERSION_1_3;
+
+        if (config.dynamic_state_level >= 1)
+            {
+                dynamic_state.setPrimitiveTopology = (PFN_vkCmdSetPrimitiveTopology)_getCommand(logical_device, _core, "vkCmdSetPrimitiveTopology", "vkCmdSetPrimitiveTopologyEXT");
+                dynamic_state.setCullMode = (PFN_vkCmdSetCullMode)_getCommand(logical_device, _core, "vkCmdSetCullMode", "vkCmdSetCullModeEXT");
+                dynamic_state.setFrontFace = (PFN_vkCmdSetFrontFace)_getCommand(logical_device, _core, "vkCmdSetFrontFace", "vkCmdSetFrontFaceEXT");
+                dynamic_state.setDepthTestEnable = (PFN_vkCmdSetDepthTestEnable)_getCommand(logical_device, _core, "vkCmdSetDepthTestEnable", "vkCmdSetDepthTestEnableEXT");
+                dynamic_state.setDepthWriteEnable = (PFN_vkCmdSetDepthWriteEnable)_getCommand(logical_device, _core, "vkCmdSetDepthWriteEnable", "vkCmdSetDepthWriteEnableEXT");
+                dynamic_state.setDepthCompareOp = (PFN_vkCmdSetDepthCompareOp)_getCommand(logical_device, _core, "vkCmdSetDepthCompareOp", "vkCmdSetDepthCompareOpEXT");
+            }
+
+        if (config.dynamic_state_level >= 2)
+            {
+                dynamic_state.setPrimitiveRestartEnable = (PFN_vkCmdSetPrimitiveRestartEnable)_getCommand(logical_device, _core, "vkCmdSetPrimitiveRestartEnable", "vkCmdSetPrimitiveRestartEnableEXT");
+            }
+
+        if (config.dynamic_state_level >= 3)
+            {
+                dynamic_state.setColorBlendEnable = (PFN_vkCmdSetColorBlendEnableEXT)vkGetDeviceProcAddr(logical_device, "vkCmdSetColorBlendEnableEXT");
+                dynamic_state.setColorBlendEquation = (PFN_vkCmdSetColorBlendEquationEXT)vkGetDeviceProcAddr(logical_device, "vkCmdSetColorBlendEquationEXT");
+                dynamic_state.setColorWriteMask = (PFN_vkCmdSetColorWriteMaskEXT)vkGetDeviceProcAddr(logical_device, "vkCmdSetColorWriteMaskEXT");
+
+                VkPhysicalDeviceExtendedDynamicState3PropertiesEXT _dynamic_state3_properties = {
+                        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_PROPERTIES_EXT,
+                        .pNext = nullptr
+                    };
+
+                VkPhysicalDeviceProperties2 _properties = {
+                        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+                        .pNext = &_dynamic_state3_properties
+                    };
+
+                vkGetPhysicalDeviceProperties2(physical_device, &_properties);
+                dynamic_state.unrestricted_topology = _dynamic_state3_properties.dynamicPrimitiveTopologyUnrestricted;
+            }
+
+        report(LOGGER::DLINE, "\t\tUnrestricted Topology: %s", dynamic_state.unrestricted_topology ? "yes" : "no");
+
+        return;
+    }
+
+
+    //////////////////
+    // RENDER STATE //
+    //////////////////
+
+static inline int _getTopologyClass(VkPrimitiveTopology topology)
+    {
+        switch (topology)
+            {
+                case VK_PRIMITIVE_TOPOLOGY_POINT_LIST: return 0;
+                case VK_PRIMITIVE_TOPOLOGY_LINE_LIST:
+                case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP:
+                case VK_PRIMITIVE_TOPOLOGY_LINE_LIST_WITH_ADJACENCY:
+                case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY: return 1;
+                case VK_PRIMITIVE_TOPOLOGY_PATCH_LIST: return 3;
+                default: return 2;
+            }
+    }
+
+// Has to agree with colorBlendAttachment() in the pipeline builder, alpha is what the pipeline bakes in
+static inline VkColorBlendEquationEXT _getBlendEquation(BLEND_MODE mode)
+    {
+        return {
+                .srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA,
+                .dstColorBlendFactor = mode == BLEND_ADDITIVE ? VK_BLEND_FACTOR_ONE : VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+                .colorBlendOp = VK_BLEND_OP_ADD,
+                .srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+                .dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO,
+                .alphaBlendOp = VK_BLEND_OP_ADD
+            };
+    }
+
+// Takes effect on the next recorded frame. Anything the device can't switch dynamically is kept as it was
+void NovaCore::setRenderState(RenderState state)
+    {
+        report(LOGGER::VERBOSE, "NovaCore - Setting Render State ..");
+
+        if (config.dynamic_state_level < 1)
+            {
+                report(LOGGER::INFO, "NovaCore - Render State Requires Extended Dynamic State, Ignoring ..");
+                return;
+            }
+
+        if (!dynamic_state.unrestricted_topology && _getTopologyClass(state.topology) != _getTopologyClass(render_state.topology))
+            {
+                report(LOGGER::INFO, "NovaCore - Topology Class Change Requires a New Pipeline, Keeping %s ..", string_VkPrimitiveTopology(render_state.topology));
+                state.topology = render_state.topology;
+            }
+
+        if (config.dynamic_state_level < 3 && state.blend != render_state.blend)
+            {
+                report(LOGGER::INFO, "NovaCore - Blend Mode Requires Extended Dynamic State 3, Ignoring ..");
+                state.blend = render_state.blend;
+            }
+
+        render_state = state;
+
+        return;
+    }
+
+void NovaCore::recordRenderState(VkCommandBuffer& command_buffer)
+    {
+        if (config.dynamic_state_level >= 1)
+            {
+                dynamic_state.setPrimitiveTopology(command_buffer, render_state.topology);
+                dynamic_state.setCullMode(command_buffer, render_state.cull_mode);
+                dynamic_state.setFrontFace(command_buffer, render_state.front_face);
+                dynamic_state.setDepthTestEnable(command_buffer, render_state.depth_test);
+                dynamic_state.setDepthWriteEnable(command_buffer, render_state.depth_write);
+                dynamic_state.setDepthCompareOp(command_buffer, render_state.depth_compare);
+            }
+
+        if (config.dynamic_state_level >= 2)
+            { dynamic_state.setPrimitiveRestartEnable(command_buffer, VK_FALSE); }
+
+        if (config.dynamic_state_level >= 3)
+            {
+                VkBool32 _blend_enable = VK_TRUE;
+                VkColorBlendEquationEXT _blend_equation = _getBlendEquation(render_state.blend);
+                VkColorComponentFlags _write_mask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+                dynamic_state.setColorBlendEnable(command_buffer, 0, 1, &_blend_enable);
+                dynamic_state.setColorBlendEquation(command_buffer, 0, 1, &_blend_equation);
+                dynamic_state.setColorWriteMask(command_buffer, 0, 1, &_write_mask);
+            }
+
+        return;
+    }
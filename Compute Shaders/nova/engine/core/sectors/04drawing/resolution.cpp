@@ -0,0 +1,178 @@
+#include "../../core.h"
+
+#include <algorithm>
+
+const float RENDER_SCALE_STEP = 0.05f;          // how far one adjustment moves the render scale
+const uint32_t RENDER_SCALE_COOLDOWN = 8;       // frames between adjustments, lets the average catch up
+
+
+    ////////////////////
+    // RENDER TARGETS //
+    ////////////////////
+
+// The scene is drawn into these at the render scale and blitted up to the swapchain image,
+// one per frame in flight so a frame never overwrites a target the previous one is still reading.
+// They're sized to the full swapchain extent so scaling never reallocates.
+void NovaCore::createRenderTargets()
+    {
+        STARTUP_STAGE();
+
+        if (!config.dynamic_resolution) { return; }
+
+        report(LOGGER::VLINE, "\t .. Creating Render Targets ..");
+
+        if (!config.dynamic_rendering)
+            {
+                report(LOGGER::INFO, "NovaCore - Dynamic Resolution Requires Dynamic Rendering, Disabling ..");
+                config.dynamic_resolution = false;
+                return;
+            }
+
+        VkFormatProperties _props;
+        vkGetPhysicalDeviceFormatProperties(physical_device, swapchain.details.surface.format, &_props);
+        const VkFormatFeatureFlags _BLIT = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+
+        if ((_props.optimalTilingFeatures & _BLIT) != _BLIT)
+            {
+                report(LOGGER::INFO, "NovaCore - %s Can't Be Blitted With Filtering, Disabling Dynamic Resolution ..", string_VkFormat(swapchain.details.surface.format));
+                config.dynamic_resolution = false;
+                return;
+            }
+
+        render_targets.resize(MAX_FRAMES_IN_FLIGHT);
+
+        for (auto& _target : render_targets)
+            {
+                VkImageCreateInfo _image_info = {
+                        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+                        .flags = 0,
+                        .imageType = VK_IMAGE_TYPE_2D,
+                        .format = swapchain.details.surface.format,
+                        .extent = { .width = swapchain.details.extent.width, .height = swapchain.details.extent.height, .depth = 1 },
+                        .mipLevels = 1,
+                        .arrayLayers = 1,
+                        .samples = VK_SAMPLE_COUNT_1_BIT,
+                        .tiling = VK_IMAGE_TILING_OPTIMAL,
+                        .usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+                        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+                    };
+
+                VK_TRY(vkCreateImage(logical_device, &_image_info, HOST_ALLOCATOR, &_target.image));
+
+                VkMemoryRequirements _mem_reqs;
+                vkGetImageMemoryRequirements(logical_device, _target.image, &_mem_reqs);
+                REGISTER_OBJECT(VK_OBJECT_TYPE_IMAGE, _target.image, _mem_reqs.size);
+
+                VkMemoryAllocateInfo _alloc_info = getMemoryAllocateInfo(_mem_reqs, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+                VK_TRY(vkAllocateMemory(logical_device, &_alloc_info, HOST_ALLOCATOR, &_target.memory));
+                REGISTER_OBJECT(VK_OBJECT_TYPE_DEVICE_MEMORY, _target.memory, _alloc_info.allocationSize);
+                VK_TRY(vkBindImageMemory(logical_device, _target.image, _target.memory, 0));
+
+                VkImageViewCreateInfo _view_info = createImageViewInfo(_target.image, swapchain.details.surface.format, VK_IMAGE_ASPECT_COLOR_BIT, 1);
+                VK_TRY(vkCreateImageView(logical_device, &_view_info, HOST_ALLOCATOR, &_target.view));
+                REGISTER_OBJECT(VK_OBJECT_TYPE_IMAGE_VIEW, _target.view, 0);
+
+                _target.sampler = VK_NULL_HANDLE;
+            }
+
+        return;
+    }
+
+// Owned by the swapchain generation they were made for, so they retire with it
+void NovaCore::destroyRenderTargets(std::vector<ImageContext>& targets)
+    {
+        for (auto& _target : targets)
+            {
+                RELEASE_OBJECT(VK_OBJECT_TYPE_IMAGE_VIEW, _target.view);
+                vkDestroyImageView(logical_device, _target.view, HOST_ALLOCATOR);
+                RELEASE_OBJECT(VK_OBJECT_TYPE_IMAGE, _target.image);
+                vkDestroyImage(logical_device, _target.image, HOST_ALLOCATOR);
+                RELEASE_OBJECT(VK_OBJECT_TYPE_DEVICE_MEMORY, _target.memory);
+                vkFreeMemory(logical_device, _target.memory, HOST_ALLOCATOR);
+            }
+
+        targets.clear();
+
+        return;
+    }
+
+// The part of the target the scene is drawn into this frame
+VkExtent2D NovaCore::renderExtent()
+    {
+        if (!config.dynamic_resolution) { return swapchain.details.extent; }
+
+        return {
+                std::max(1u, static_cast<uint32_t>(swapchain.details.extent.width * render_scale)),
+                std::max(1u, static_cast<uint32_t>(swapchain.details.extent.height * render_scale))
+            };
+    }
+
+// Stretches the rendered region over the whole swapchain image and leaves it in the target layout.
+// The swapchain barrier starts from color output, which chains it behind the acquire semaphore wait.
+void NovaCore::recordUpscale(VkCommandBuffer& command_buffer, uint32_t i)
+    {
+        VkImage _target = render_targets[_frame_ct].image;
+        VkExtent2D _render_extent = renderExtent();
+        VkExtent2D _extent = swapchain.details.extent;
+        VkImageLayout _final_layout = getTargetLayout();
+
+        recordImageBarrier(command_buffer, _target, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+
+        recordImageBarrier(command_buffer, swapchain.images[i], VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0,
+                            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+
+        VkImageBlit _blit = {
+                .srcSubresource = { .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT, .mipLevel = 0, .baseArrayLayer = 0, .layerCount = 1 },
+                .srcOffsets = { { 0, 0, 0 }, { (int32_t)_render_extent.width, (int32_t)_render_extent.height, 1 } },
+                .dstSubresource = { .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT, .mipLevel = 0, .baseArrayLayer = 0, .layerCount = 1 },
+                .dstOffsets = { { 0, 0, 0 }, { (int32_t)_extent.width, (int32_t)_extent.height, 1 } }
+            };
+
+        vkCmdBlitImage(command_buffer, _target, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                        swapchain.images[i], VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &_blit, VK_FILTER_LINEAR);
+
+        // Presenting needs no access, a headless target is handed to whatever copies it out next
+        bool _readback = _final_layout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        recordImageBarrier(command_buffer, swapchain.images[i], VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, _final_layout,
+                            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                            _readback ? VK_PIPELINE_STAGE_TRANSFER_BIT : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                            _readback ? VK_ACCESS_TRANSFER_READ_BIT : 0);
+
+        return;
+    }
+
+
+    //////////////////////
+    // GPU FRAME TIMING //
+    //////////////////////
+
+// Called after the profiler collects the slot. Averages the graphics command buffer's GPU time
+// and steps the render scale down when over budget, back up once there's comfortable headroom.
+void NovaCore::updateRenderScale()
+    {
+        double _ms;
+        if (!config.dynamic_resolution || !gpu_profiler.sample("Graphics", &_ms)) { return; }
+
+        gpu_frame_ms = gpu_frame_ms == 0.0 ? _ms : gpu_frame_ms * 0.9 + _ms * 0.1;
+
+        if (frame_number % RENDER_SCALE_COOLDOWN != 0) { return; }
+
+        float _scale = render_scale;
+
+        if (gpu_frame_ms > config.frame_budget_ms)
+            { _scale = std::max(config.min_render_scale, render_scale - RENDER_SCALE_STEP); }
+        else if (gpu_frame_ms < config.frame_budget_ms * 0.75)
+            { _scale = std::min(1.0f, render_scale + RENDER_SCALE_STEP); }
+
+        if (_scale != render_scale)
+            {
+                report(LOGGER::VERBOSE, "NovaCore - GPU %.2f ms, Render Scale %.2f ..", gpu_frame_ms, _scale);
+                render_scale = _scale;
+            }
+
+        return;
+    }
@@ -1,7 +1,5 @@
 #include "../../core.h"
 
-#include <SDL2/SDL_timer.h>
-
     /////////////////////
     // SYNC STRUCTURES //
     /////////////////////
@@ -30,6 +28,8 @@ static VkFenceCreateInfo createFenceInfo()
 
 void NovaCore::createSyncObjects() 
     {
+        STARTUP_STAGE();
+
         report(LOGGER::VLINE, "\t .. Creating Sync Objects ..");
 
         for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) 
@@ -37,15 +37,20 @@ void NovaCore::createSyncObjects()
                 VkSemaphoreCreateInfo frames_semaphore_info = createSemaphoreInfo();
                 VkFenceCreateInfo frames_fence_info = createFenceInfo();
 
-                VK_TRY(vkCreateSemaphore(logical_device, &frames_semaphore_info, nullptr, &frames[i].image_available));
-                VK_TRY(vkCreateSemaphore(logical_device, &frames_semaphore_info, nullptr, &frames[i].render_finished));
-                VK_TRY(vkCreateFence(logical_device, &frames_fence_info, nullptr, &frames[i].in_flight));
+                VK_TRY(vkCreateSemaphore(logical_device, &frames_semaphore_info, HOST_ALLOCATOR, &frames[i].image_available));
+                REGISTER_OBJECT(VK_OBJECT_TYPE_SEMAPHORE, frames[i].image_available, 0);
+                VK_TRY(vkCreateSemaphore(logical_device, &frames_semaphore_info, HOST_ALLOCATOR, &frames[i].render_finished));
+                REGISTER_OBJECT(VK_OBJECT_TYPE_SEMAPHORE, frames[i].render_finished, 0);
+                VK_TRY(vkCreateFence(logical_device, &frames_fence_info, HOST_ALLOCATOR, &frames[i].in_flight));
+                REGISTER_OBJECT(VK_OBJECT_TYPE_FENCE, frames[i].in_flight, 0);
                 
                 VkSemaphoreCreateInfo computes_semaphore_info = createSemaphoreInfo();
                 VkFenceCreateInfo computes_fence_info = createFenceInfo();
 
-                VK_TRY(vkCreateSemaphore(logical_device, &computes_semaphore_info, nullptr, &computes[i].finished));
-                VK_TRY(vkCreateFence(logical_device, &computes_fence_info, nullptr, &computes[i].in_flight));
+                VK_TRY(vkCreateSemaphore(logical_device, &computes_semaphore_info, HOST_ALLOCATOR, &computes[i].finished));
+                REGISTER_OBJECT(VK_OBJECT_TYPE_SEMAPHORE, computes[i].finished, 0);
+                VK_TRY(vkCreateFence(logical_device, &computes_fence_info, HOST_ALLOCATOR, &computes[i].in_flight));
+                REGISTER_OBJECT(VK_OBJECT_TYPE_FENCE, computes[i].in_flight, 0);
             }
 
         return;
@@ -53,7 +58,35 @@ void NovaCore::createSyncObjects()
 
 void NovaCore::syncClock()
     {
-        double current_time = SDL_GetTicks64() / 1000.0;
+        double current_time = frame_stats.seconds();
         last_frame_time = current_time - last_time;
         last_time = current_time;
-    }
\ No newline at end of file
+        frame_stats.tick();
+    }
+
+    ///////////////////////////
+    // SIMULATION PARAMETERS //
+    ///////////////////////////
+
+// Cheap integer hash so every dispatch gets a fresh seed without an RNG on the host
+static inline uint32_t _hashSeed(uint32_t x)
+    {
+        x ^= x >> 16;
+        x *= 0x7feb352d;
+        x ^= x >> 15;
+        x *= 0x846ca68b;
+        x ^= x >> 16;
+        return x;
+    }
+
+void NovaCore::updateSimulation()
+    {
+        simulation.deltaTime = last_frame_time / 3.0f;
+        simulation.time = static_cast<float>(last_time);
+        simulation.seed = _hashSeed(simulation.seed + 1);
+        simulation.emitter = 0;
+        simulation.substeps = config.substeps;
+        simulation.disk_speed = config.disk_speed;
+
+        return;
+    }
@@ -0,0 +1,133 @@
+#include "../../core.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sys/resource.h>
+
+static const char* _GPU_SCOPES[] = { "Compute", "Render", "Graphics" };
+static const char* _BACKEND_KEYS[] = { "descriptor_sets", "bindless", "push_descriptors", "descriptor_buffer" };
+
+    ///////////////
+    // BENCHMARK //
+    ///////////////
+
+// Everything before this frame was warm up: pipelines compiling, caches filling, clocks ramping
+void NovaCore::startBenchmark()
+    {
+        report(LOGGER::INFO, "NovaCore - Warmed Up After %llu Frames, Benchmarking ..", (unsigned long long)frame_number);
+
+        frame_stats.reset();
+        gpu_profiler.reset();
+
+        return;
+    }
+
+// What's resident in the device local heaps, from VK_EXT_memory_budget, or -1 without it
+double NovaCore::deviceMemoryMB()
+    {
+        if (!device_features.enabled(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)) { return -1.0; }
+
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT _budget = {
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT,
+                .pNext = nullptr
+            };
+
+        VkPhysicalDeviceMemoryProperties2 _memory = {
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2,
+                .pNext = &_budget
+            };
+
+        vkGetPhysicalDeviceMemoryProperties2(physical_device, &_memory);
+
+        VkDeviceSize _used = 0;
+        for (uint32_t i = 0; i < _memory.memoryProperties.memoryHeapCount; i++)
+            {
+                if (_memory.memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+                    { _used += _budget.heapUsage[i]; }
+            }
+
+        return _used / (1024.0 * 1024.0);
+    }
+
+// Appends this run to <bench_path>.jsonl and <bench_path>.csv, the CSV gets its header when it's new
+void NovaCore::writeBenchmark()
+    {
+        std::string _jsonl_path = std::string(config.bench_path) + ".jsonl";
+        std::string _csv_path = std::string(config.bench_path) + ".csv";
+
+        FILE* _jsonl = fopen(_jsonl_path.c_str(), "a");
+        FILE* _csv = fopen(_csv_path.c_str(), "a");
+        if (_jsonl == nullptr || _csv == nullptr)
+            {
+                report(LOGGER::ERROR, "NovaCore - Could not open %s for the benchmark results ..", config.bench_path);
+                if (_jsonl) { fclose(_jsonl); }
+                if (_csv) { fclose(_csv); }
+                return;
+            }
+
+        rusage _usage;
+        getrusage(RUSAGE_SELF, &_usage);
+        double _rss_mb = _usage.ru_maxrss / 1024.0;
+        double _device_mb = deviceMemoryMB();
+
+        std::vector<GpuScopeStats> _gpu = gpu_profiler.stats();
+        uint64_t _frames = frame_stats.histogram(METRIC_CPU_FRAME).count();
+        const char* _policy = config.headless ? "headless" : PRESENT_POLICY_KEYS[config.present_policy];
+
+        // JSON lines
+        fprintf(_jsonl, "{\"device\": \"%s\", \"particles\": %u, \"workgroup_size\": %u, \"present_policy\": \"%s\", \"binding_backend\": \"%s\", "
+                        "\"frames\": %llu, \"warmup\": %llu, \"stutters\": %llu, \"frame_ms\": %s, \"gpu_ms\": {",
+                device_properties.deviceName, config.particle_count, config.workgroup_size, _policy, _BACKEND_KEYS[config.binding_backend],
+                (unsigned long long)_frames, (unsigned long long)config.bench_warmup, (unsigned long long)frame_stats.stutters(),
+                frame_stats.json().c_str());
+
+        for (size_t i = 0; i < _gpu.size(); i++)
+            {
+                fprintf(_jsonl, "%s\"%s\": {\"min\": %.4f, \"avg\": %.4f, \"p99\": %.4f, \"samples\": %u}", i ? ", " : "",
+                        _gpu[i].name, _gpu[i].min_ms, _gpu[i].avg_ms, _gpu[i].p99_ms, _gpu[i].samples);
+            }
+
+        fprintf(_jsonl, "}, \"memory_mb\": {\"device_local\": %.2f, \"peak_rss\": %.2f}}\n", _device_mb, _rss_mb);
+
+        // CSV, fixed columns so runs line up whatever the device could measure
+        fseek(_csv, 0, SEEK_END);
+        if (ftell(_csv) == 0)
+            {
+                fprintf(_csv, "device,particles,workgroup_size,present_policy,binding_backend,frames,stutters");
+                for (uint32_t i = 0; i < METRIC_COUNT; i++)
+                    {
+                        for (uint32_t p = 0; p < REPORT_PERCENTILE_COUNT; p++) { fprintf(_csv, ",%s_%s", FRAME_METRIC_KEYS[i], REPORT_PERCENTILE_KEYS[p]); }
+                        fprintf(_csv, ",%s_max", FRAME_METRIC_KEYS[i]);
+                    }
+                for (const char* _scope : _GPU_SCOPES) { fprintf(_csv, ",gpu_%s_avg,gpu_%s_p99", _scope, _scope); }
+                fprintf(_csv, ",device_local_mb,peak_rss_mb\n");
+            }
+
+        fprintf(_csv, "\"%s\",%u,%u,%s,%s,%llu,%llu", device_properties.deviceName, config.particle_count, config.workgroup_size,
+                _policy, _BACKEND_KEYS[config.binding_backend], (unsigned long long)_frames, (unsigned long long)frame_stats.stutters());
+
+        for (uint32_t i = 0; i < METRIC_COUNT; i++)
+            {
+                LatencyHistogram& _histogram = frame_stats.histogram((FRAME_METRIC)i);
+                for (uint32_t p = 0; p < REPORT_PERCENTILE_COUNT; p++) { fprintf(_csv, ",%.4f", _histogram.percentile(REPORT_PERCENTILES[p])); }
+                fprintf(_csv, ",%.4f", _histogram.max());
+            }
+
+        for (const char* _scope : _GPU_SCOPES)
+            {
+                double _avg = 0.0, _p99 = 0.0;
+                for (const GpuScopeStats& _stats : _gpu)
+                    { if (strcmp(_stats.name, _scope) == 0) { _avg = _stats.avg_ms; _p99 = _stats.p99_ms; } }
+                fprintf(_csv, ",%.4f,%.4f", _avg, _p99);
+            }
+
+        fprintf(_csv, ",%.2f,%.2f\n", _device_mb, _rss_mb);
+
+        fclose(_jsonl);
+        fclose(_csv);
+
+        report(LOGGER::INFO, "NovaCore - Benchmark of %llu Frames Appended to %s ..", (unsigned long long)_frames, config.bench_path);
+
+        return;
+    }
@@ -0,0 +1,220 @@
+#include "../../core.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <string>
+
+static const char* _LEVEL_KEYS[] = { "off", "error", "iline", "info", "dline", "debug", "vline", "verbose" };
+static const char* _TUNABLES[] = { "particles", "substeps", "disk_speed", "present_policy", "workgroup_size", "log_level", "hud" };
+
+static const char* _CONTROL_HELP =
+        "stats | get <tunable> | set <tunable> <value> | help, tunables: "
+        "particles substeps disk_speed present_policy workgroup_size log_level hud";
+
+    /////////////
+    // CONTROL //
+    /////////////
+
+static void _appendf(std::string& out, const char* format, ...) __attribute__((format(printf, 2, 3)));
+static void _appendf(std::string& out, const char* format, ...)
+    {
+        char _buffer[512];
+
+        va_list _args;
+        va_start(_args, format);
+        int _length = vsnprintf(_buffer, sizeof(_buffer), format, _args);
+        va_end(_args);
+
+        if (_length > 0) { out.append(_buffer, std::min((size_t)_length, sizeof(_buffer) - 1)); }
+
+        return;
+    }
+
+static inline bool _parseUnsigned(const char* text, uint32_t* value)
+    {
+        char* _end;
+        unsigned long _value = std::strtoul(text, &_end, 10);
+        if (_end == text || *_end != '\0' || text[0] == '-' || _value > UINT32_MAX) { return false; }
+
+        *value = static_cast<uint32_t>(_value);
+        return true;
+    }
+
+static inline int _findKey(const char* const* keys, int count, const char* text)
+    {
+        for (int i = 0; i < count; i++) { if (strcmp(keys[i], text) == 0) { return i; } }
+        return -1;
+    }
+
+// One command per line from the ControlSocket, called between frames so anything it changes
+// is in place before the next one is recorded. The reply is a single line, JSON for stats.
+void NovaCore::control(const char* line, std::string& reply)
+    {
+        char _line[CONTROL_LINE_LENGTH];
+        strncpy(_line, line, sizeof(_line) - 1);
+        _line[sizeof(_line) - 1] = '\0';
+
+        char* _save;
+        const char* _command = strtok_r(_line, " \t", &_save);
+        const char* _key = strtok_r(nullptr, " \t", &_save);
+        const char* _value = strtok_r(nullptr, " \t", &_save);
+
+        if (_command == nullptr) { return; }
+
+        if (strcmp(_command, "stats") == 0) { controlStats(reply); }
+        else if (strcmp(_command, "get") == 0 && _key != nullptr) { controlGet(_key, reply); }
+        else if (strcmp(_command, "set") == 0 && _key != nullptr && _value != nullptr) { controlSet(_key, _value, reply); }
+        else if (strcmp(_command, "help") == 0) { reply = _CONTROL_HELP; }
+        else { _appendf(reply, "error unknown command '%s', try help", line); }
+
+        return;
+    }
+
+void NovaCore::controlStats(std::string& reply)
+    {
+        const char* _policy = config.headless ? "headless" : PRESENT_POLICY_KEYS[config.present_policy];
+        const char* _mode = config.headless ? "none" : string_VkPresentModeKHR(swapchain.details.present_mode);
+
+        _appendf(reply, "{\"frame\": %llu, \"particles\": %u, \"particle_capacity\": %u, \"substeps\": %u, \"disk_speed\": %.4f, "
+                        "\"workgroup_size\": %u, \"present_policy\": \"%s\", \"present_mode\": \"%s\", \"render_scale\": %.3f, "
+                        "\"stutters\": %llu, \"frame_ms\": ",
+                (unsigned long long)frame_number, config.particle_count, particle_capacity, config.substeps, config.disk_speed,
+                config.workgroup_size, _policy, _mode, render_scale, (unsigned long long)frame_stats.stutters());
+
+        reply += frame_stats.json();
+        reply += ", \"gpu_ms\": {";
+
+        std::vector<GpuScopeStats> _gpu = gpu_profiler.stats();
+        for (size_t i = 0; i < _gpu.size(); i++)
+            {
+                _appendf(reply, "%s\"%s\": {\"last\": %.4f, \"min\": %.4f, \"avg\": %.4f, \"p99\": %.4f}", i ? ", " : "",
+                        _gpu[i].name, _gpu[i].last_ms, _gpu[i].min_ms, _gpu[i].avg_ms, _gpu[i].p99_ms);
+            }
+
+        _appendf(reply, "}, \"memory_mb\": {\"device_local\": %.2f, \"particles\": %.2f}, \"objects\": %llu}",
+                deviceMemoryMB(), sizeof(Particle) * (double)particle_capacity * MAX_FRAMES_IN_FLIGHT / (1024.0 * 1024.0),
+                (unsigned long long)ObjectRegistry::get().live());
+
+        return;
+    }
+
+void NovaCore::controlGet(const char* key, std::string& reply)
+    {
+        switch (_findKey(_TUNABLES, std::size(_TUNABLES), key))
+            {
+                case 0: _appendf(reply, "particles %u", config.particle_count); break;
+                case 1: _appendf(reply, "substeps %u", config.substeps); break;
+                case 2: _appendf(reply, "disk_speed %.4f", config.disk_speed); break;
+                case 3: _appendf(reply, "present_policy %s", config.headless ? "headless" : PRESENT_POLICY_KEYS[config.present_policy]); break;
+                case 4: _appendf(reply, "workgroup_size %u", config.workgroup_size); break;
+                case 5: _appendf(reply, "log_level %s", _LEVEL_KEYS[getLogLevel()]); break;
+                case 6: _appendf(reply, "hud %u", hud_pipeline != nullptr && hud_visible ? 1u : 0u); break;
+                default: _appendf(reply, "error unknown tunable '%s'", key); break;
+            }
+
+        return;
+    }
+
+// Validates before touching anything, so a rejected value leaves the engine as it was
+void NovaCore::controlSet(const char* key, const char* value, std::string& reply)
+    {
+        VkPhysicalDeviceLimits& _limits = device_properties.limits;
+        uint32_t _number = 0;
+        bool _numeric = _parseUnsigned(value, &_number);
+
+        switch (_findKey(_TUNABLES, std::size(_TUNABLES), key))
+            {
+                // Up to what the storage buffers were sized for, the rest of them just stop being simulated and drawn
+                case 0:
+                    if (!_numeric || _number == 0 || _number > particle_capacity)
+                        { _appendf(reply, "error particles must be 1 to %u, the capacity allocated at start up", particle_capacity); return; }
+                    if ((_number - 1) / config.workgroup_size >= _limits.maxComputeWorkGroupCount[0])
+                        { _appendf(reply, "error %u particles can't be dispatched in workgroups of %u", _number, config.workgroup_size); return; }
+
+                    config.particle_count = _number;
+                    pipeline_statistics.expect(_number);
+                    break;
+
+                case 1:
+                    if (!_numeric || _number == 0 || _number > 64)
+                        { reply = "error substeps must be 1 to 64"; return; }
+
+                    config.substeps = _number;
+                    break;
+
+                case 2:
+                    {
+                        char* _end;
+                        float _speed = std::strtof(value, &_end);
+                        if (_end == value || *_end != '\0')
+                            { reply = "error disk_speed must be a number"; return; }
+
+                        config.disk_speed = _speed;
+                        break;
+                    }
+
+                case 3:
+                    {
+                        int _policy = _findKey(PRESENT_POLICY_KEYS, std::size(PRESENT_POLICY_KEYS), value);
+                        if (_policy < 0)
+                            { reply = "error present_policy must be latency, throughput, power_save or uncapped"; return; }
+                        if (config.headless)
+                            { reply = "error headless runs have no swapchain to present to"; return; }
+
+                        setPresentPolicy((PRESENT_POLICY)_policy);
+                        _appendf(reply, "ok present_policy %s %s", PRESENT_POLICY_KEYS[config.present_policy], string_VkPresentModeKHR(swapchain.details.present_mode));
+                        return;
+                    }
+
+                // The size is specialized into the shader, so this waits for the device and rebuilds the compute pipeline
+                case 4:
+                    {
+                        uint32_t _max_workgroup = std::min(_limits.maxComputeWorkGroupSize[0], _limits.maxComputeWorkGroupInvocations);
+                        if (!_numeric || _number == 0 || _number > _max_workgroup)
+                            { _appendf(reply, "error workgroup_size must be 1 to %u", _max_workgroup); return; }
+                        if ((config.particle_count - 1) / _number >= _limits.maxComputeWorkGroupCount[0])
+                            { _appendf(reply, "error %u particles can't be dispatched in workgroups of %u", config.particle_count, _number); return; }
+                        if (_number == config.workgroup_size) { break; }
+
+                        VK_TRY(vkDeviceWaitIdle(logical_device));
+                        destroyPipeline(compute_pipeline);
+                        config.workgroup_size = _number;
+                        constructComputePipeline();
+                        break;
+                    }
+
+                case 5:
+                    {
+                        int _level = _findKey(_LEVEL_KEYS, std::size(_LEVEL_KEYS), value);
+                        if (_level < 0)
+                            { reply = "error log_level must be off, error, iline, info, dline, debug, vline or verbose"; return; }
+
+                        setLogLevel((LOGGER)_level);
+                        break;
+                    }
+
+                case 6:
+                    if (!_numeric || _number > 1)
+                        { reply = "error hud must be 0 or 1"; return; }
+                    if (hud_pipeline == nullptr)
+                        { reply = "error no hud, run with NOVA_HUD=1"; return; }
+
+                    if ((_number == 1) != hud_visible) { toggleHud(); }
+                    break;
+
+                default:
+                    _appendf(reply, "error unknown tunable '%s'", key);
+                    return;
+            }
+
+        report(LOGGER::INFO, "NovaCore - Control Set %s to %s ..", key, value);
+
+        reply = "ok ";
+        controlGet(key, reply);
+
+        return;
+    }
@@ -0,0 +1,273 @@
+#include "gpu_profiler.h"
+
+#include <algorithm>
+#include <cstring>
+
+static inline uint64_t _getTickMask(uint32_t valid_bits)
+    { return valid_bits >= 64 ? UINT64_MAX : (1ULL << valid_bits) - 1; }
+
+GpuProfiler::GpuProfiler()
+    {
+        _device = nullptr;
+        _pool = VK_NULL_HANDLE;
+        _period_ns = 1.0;
+        _calibrate = nullptr;
+        _device_epoch = 0;
+        _host_epoch = 0;
+    }
+
+GpuProfiler::~GpuProfiler()
+    {
+        if (_pool != VK_NULL_HANDLE)
+            { report(LOGGER::ERROR, "GpuProfiler - Query Pool was never destroyed .."); }
+    }
+
+// Two queries per scope, MAX_GPU_SCOPES scopes per frame in flight
+void GpuProfiler::init(VkDevice* logical_device, VkPhysicalDevice physical_device, uint32_t frames)
+    {
+        report(LOGGER::VLINE, "\t .. Initializing GPU Profiler ..");
+
+        VkPhysicalDeviceProperties _properties;
+        vkGetPhysicalDeviceProperties(physical_device, &_properties);
+
+        uint32_t _family_ct = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &_family_ct, nullptr);
+        std::vector<VkQueueFamilyProperties> _families(_family_ct);
+        vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &_family_ct, _families.data());
+
+        _valid_bits.resize(_family_ct);
+        for (uint32_t i = 0; i < _family_ct; i++)
+            { _valid_bits[i] = _families[i].timestampValidBits; }
+
+        _device = logical_device;
+        _period_ns = _properties.limits.timestampPeriod;
+        _queries.assign(frames, {});
+
+        VkQueryPoolCreateInfo _pool_info = {
+                .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+                .pNext = nullptr,
+                .flags = 0,
+                .queryType = VK_QUERY_TYPE_TIMESTAMP,
+                .queryCount = frames * MAX_GPU_SCOPES * 2,
+                .pipelineStatistics = 0
+            };
+
+        VK_TRY(vkCreateQueryPool(*_device, &_pool_info, HOST_ALLOCATOR, &_pool));
+        REGISTER_OBJECT(VK_OBJECT_TYPE_QUERY_POOL, _pool, 0);
+
+        report(LOGGER::DLINE, "\t\tTimestamp Period: %.2f ns", _period_ns);
+
+        return;
+    }
+
+void GpuProfiler::destroy()
+    {
+        if (_pool == VK_NULL_HANDLE) { return; }
+
+        report(LOGGER::VLINE, "\t .. Destroying GPU Profiler ..");
+
+        RELEASE_OBJECT(VK_OBJECT_TYPE_QUERY_POOL, _pool);
+        vkDestroyQueryPool(*_device, _pool, HOST_ALLOCATOR);
+        _pool = VK_NULL_HANDLE;
+
+        return;
+    }
+
+uint32_t GpuProfiler::_getScope(const char* name)
+    {
+        for (uint32_t i = 0; i < _scopes.size(); i++)
+            { if (strcmp(_scopes[i].name, name) == 0) { return i; } }
+
+        _scopes.push_back({ .name = name, .window = {}, .samples = 0 });
+        _scopes.back().window.reserve(GPU_SCOPE_WINDOW);
+
+        return static_cast<uint32_t>(_scopes.size() - 1);
+    }
+
+
+    ////////////
+    // SCOPES //
+    ////////////
+
+// Recorded outside any render pass, the pair is reset in the same command buffer that writes it.
+// family is the queue family the command buffer will be submitted to.
+uint32_t GpuProfiler::begin(VkCommandBuffer command_buffer, uint32_t frame, uint32_t family, const char* name)
+    {
+        if (_pool == VK_NULL_HANDLE || !timed(family) || _queries[frame].size() >= MAX_GPU_SCOPES)
+            { return NO_GPU_SCOPE; }
+
+        uint32_t _handle = static_cast<uint32_t>(_queries[frame].size());
+        uint32_t _query = (frame * MAX_GPU_SCOPES + _handle) * 2;
+
+        _queries[frame].push_back({ .scope = _getScope(name), .family = family, .ended = false, .read = false, .ms = 0.0 });
+
+        vkCmdResetQueryPool(command_buffer, _pool, _query, 2);
+        vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, _pool, _query);
+
+        return _handle;
+    }
+
+void GpuProfiler::end(VkCommandBuffer command_buffer, uint32_t frame, uint32_t handle)
+    {
+        if (handle == NO_GPU_SCOPE) { return; }
+
+        uint32_t _query = (frame * MAX_GPU_SCOPES + handle) * 2;
+        vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, _pool, _query + 1);
+        _queries[frame][handle].ended = true;
+
+        return;
+    }
+
+// Only once the frame's fences have signaled. Anything recorded but never submitted
+// reads back as not ready and is dropped, then the slot is cleared for the frame about to be recorded.
+void GpuProfiler::collect(uint32_t frame)
+    {
+        if (_pool == VK_NULL_HANDLE) { return; }
+
+        std::vector<Query>& _frame_queries = _queries[frame];
+        bool _tracing = _calibrate != nullptr && TraceRecorder::get().open() && _calibrateClocks();
+
+        for (uint32_t i = 0; i < _frame_queries.size(); i++)
+            {
+                Query& _entry = _frame_queries[i];
+                if (!_entry.ended) { continue; }
+
+                uint64_t _ticks[2];
+                uint32_t _query = (frame * MAX_GPU_SCOPES + i) * 2;
+                VkResult _result = vkGetQueryPoolResults(*_device, _pool, _query, 2, sizeof(_ticks), _ticks, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+
+                if (_result != VK_SUCCESS) { continue; }
+
+                uint32_t _bits = _valid_bits[_entry.family];
+                _entry.ms = (double)((_ticks[1] - _ticks[0]) & _getTickMask(_bits)) * _period_ns / 1e6;
+                _entry.read = true;
+
+                Scope& _scope = _scopes[_entry.scope];
+                if (_scope.window.size() < GPU_SCOPE_WINDOW) { _scope.window.push_back(_entry.ms); }
+                else { _scope.window[_scope.samples % GPU_SCOPE_WINDOW] = _entry.ms; }
+                _scope.samples++;
+
+                if (_tracing)
+                    {
+                        TraceRecorder::get().record(_scope.name, TraceRecorder::gpuTrack(_entry.family),
+                                                    _toHost(_ticks[0], _bits), _toHost(_ticks[1], _bits));
+                    }
+            }
+
+        _last_read.assign(_frame_queries.begin(), _frame_queries.end());
+        _frame_queries.clear();
+
+        return;
+    }
+
+// The time the named scope took in the frame collect() last read
+bool GpuProfiler::sample(const char* name, double* ms)
+    {
+        for (const Query& _entry : _last_read)
+            {
+                if (_entry.read && strcmp(_scopes[_entry.scope].name, name) == 0)
+                    {
+                        *ms = _entry.ms;
+                        return true;
+                    }
+            }
+
+        return false;
+    }
+
+
+    /////////////////
+    // CALIBRATION //
+    /////////////////
+
+// Taken fresh for every frame read so the two clocks can't drift apart over a trace
+bool GpuProfiler::_calibrateClocks()
+    {
+        VkCalibratedTimestampInfoEXT _domains[2] = {
+                { .sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT, .pNext = nullptr, .timeDomain = VK_TIME_DOMAIN_DEVICE_EXT },
+                { .sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT, .pNext = nullptr, .timeDomain = VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT }
+            };
+
+        uint64_t _stamps[2];
+        uint64_t _deviation;
+
+        if (_calibrate(*_device, 2, _domains, _stamps, &_deviation) != VK_SUCCESS) { return false; }
+
+        _device_epoch = _stamps[0];
+        _host_epoch = _stamps[1];
+
+        return true;
+    }
+
+// Scopes were written before the epoch, so the masked difference is sign extended from the valid bits
+uint64_t GpuProfiler::_toHost(uint64_t ticks, uint32_t valid_bits)
+    {
+        uint64_t _mask = _getTickMask(valid_bits);
+        uint64_t _delta = (ticks - _device_epoch) & _mask;
+        bool _negative = valid_bits < 64 && (_delta >> (valid_bits - 1)) != 0;
+        int64_t _signed = _negative ? (int64_t)(_delta - _mask - 1) : (int64_t)_delta;
+
+        return _host_epoch + (int64_t)(_signed * _period_ns);
+    }
+
+
+    ////////////////
+    // STATISTICS //
+    ////////////////
+
+std::vector<GpuScopeStats> GpuProfiler::stats()
+    {
+        std::vector<GpuScopeStats> _stats;
+
+        for (const Scope& _scope : _scopes)
+            {
+                if (_scope.window.empty()) { continue; }
+
+                std::vector<double> _sorted = _scope.window;
+                std::sort(_sorted.begin(), _sorted.end());
+
+                double _sum = 0.0;
+                for (double _ms : _sorted) { _sum += _ms; }
+
+                size_t _p99 = (_sorted.size() * 99 + 99) / 100 - 1;
+
+                _stats.push_back({
+                        .name = _scope.name,
+                        .last_ms = _scope.window[(_scope.samples - 1) % GPU_SCOPE_WINDOW],
+                        .min_ms = _sorted.front(),
+                        .avg_ms = _sum / _sorted.size(),
+                        .p99_ms = _sorted[_p99],
+                        .samples = static_cast<uint32_t>(_sorted.size())
+                    });
+            }
+
+        return _stats;
+    }
+
+// Drops every scope's samples, the scopes themselves stay
+void GpuProfiler::reset()
+    {
+        for (Scope& _scope : _scopes)
+            {
+                _scope.window.clear();
+                _scope.samples = 0;
+            }
+
+        return;
+    }
+
+void GpuProfiler::log()
+    {
+        std::vector<GpuScopeStats> _stats = stats();
+        if (_stats.empty()) { return; }
+
+        report(LOGGER::INFO, "GpuProfiler - Last %u Frames ..", GPU_SCOPE_WINDOW);
+
+        for (const GpuScopeStats& _scope : _stats)
+            {
+                report(LOGGER::ILINE, "\t%-16s min %7.3f  avg %7.3f  p99 %7.3f ms",
+                        _scope.name, _scope.min_ms, _scope.avg_ms, _scope.p99_ms);
+            }
+
+        return;
+    }
@@ -0,0 +1,80 @@
+#pragma once
+#include "../00atomic/atomic.h"
+
+#include <vector>
+
+const uint32_t MAX_GPU_SCOPES = 16;             // scopes one frame can open across all its command buffers
+const uint32_t GPU_SCOPE_WINDOW = 128;          // samples each scope's statistics are taken over
+const uint32_t NO_GPU_SCOPE = UINT32_MAX;       // what begin() hands back when the queue can't be timed
+
+struct GpuScopeStats
+    {
+        const char* name;
+        double last_ms;
+        double min_ms;
+        double avg_ms;
+        double p99_ms;
+        uint32_t samples;
+    };
+
+/*
+    The GpuProfiler brackets named scopes in a command buffer with a pair of timestamps. Each frame
+    in flight owns its own range of queries, so collect() on a slot after its fences are waited on
+    reads results one or two frames late without ever stalling. Every scope keeps a rolling window
+    of its times for min, average and p99. Queue families without timestamp support are skipped,
+    and the difference between a pair is masked to the family's valid bits so counters can wrap.
+    Given vkGetCalibratedTimestampsEXT, every scope read while a trace is open is also mapped onto
+    CLOCK_MONOTONIC and handed to the TraceRecorder on its queue family's track.
+*/
+
+class GpuProfiler {
+    public:
+        GpuProfiler();
+        ~GpuProfiler();
+
+        void init(VkDevice*, VkPhysicalDevice, uint32_t);
+        void destroy();
+        void calibrate(PFN_vkGetCalibratedTimestampsEXT calibrate) { _calibrate = calibrate; }
+        bool enabled() { return _pool != VK_NULL_HANDLE; }
+        bool timed(uint32_t family) { return family < _valid_bits.size() && _valid_bits[family] != 0; }
+
+        uint32_t begin(VkCommandBuffer, uint32_t, uint32_t, const char*);
+        void end(VkCommandBuffer, uint32_t, uint32_t);
+        void collect(uint32_t);
+        bool sample(const char*, double*);
+        std::vector<GpuScopeStats> stats();
+        void reset();
+        void log();
+
+    private:
+        struct Scope
+            {
+                const char* name;
+                std::vector<double> window;     // ring of the latest GPU_SCOPE_WINDOW samples
+                uint64_t samples;
+            };
+
+        struct Query
+            {
+                uint32_t scope;
+                uint32_t family;
+                bool ended;
+                bool read;
+                double ms;
+            };
+
+        VkDevice* _device;
+        VkQueryPool _pool;
+        double _period_ns;
+        PFN_vkGetCalibratedTimestampsEXT _calibrate;
+        uint64_t _device_epoch;                 // a device tick and the CLOCK_MONOTONIC time it was taken at
+        uint64_t _host_epoch;
+        std::vector<uint32_t> _valid_bits;      // per queue family, 0 where timestamps aren't supported
+        std::vector<Scope> _scopes;
+        std::vector<std::vector<Query>> _queries;   // per frame, in the order the scopes were opened
+        std::vector<Query> _last_read;              // the frame collect() read last, for sample()
+
+        uint32_t _getScope(const char*);
+        bool _calibrateClocks();
+        uint64_t _toHost(uint64_t, uint32_t);
+};
@@ -0,0 +1,187 @@
+#include "pipeline_statistics.h"
+
+static const VkQueryPipelineStatisticFlags _STATISTICS[] = {
+        VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT,
+        VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT
+            | VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT
+            | VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT
+    };
+
+PipelineStatistics::PipelineStatistics()
+    {
+        _device = nullptr;
+        _pools[QUERY_COMPUTE] = VK_NULL_HANDLE;
+        _pools[QUERY_GRAPHICS] = VK_NULL_HANDLE;
+        _expected = 0;
+        _short_dispatch = false;
+        _last = {};
+        _total = {};
+        _frames[QUERY_COMPUTE] = 0;
+        _frames[QUERY_GRAPHICS] = 0;
+        _particles[QUERY_COMPUTE] = 0;
+        _particles[QUERY_GRAPHICS] = 0;
+    }
+
+PipelineStatistics::~PipelineStatistics()
+    {
+        if (enabled())
+            { report(LOGGER::ERROR, "PipelineStatistics - Query Pools were never destroyed .."); }
+    }
+
+// One query per half per frame in flight, expected is the particle count both halves should cover
+void PipelineStatistics::init(VkDevice* logical_device, uint32_t frames, uint64_t expected)
+    {
+        report(LOGGER::VLINE, "\t .. Initializing Pipeline Statistics ..");
+
+        _device = logical_device;
+        _expected = expected;
+
+        for (uint32_t i = 0; i < 2; i++)
+            {
+                VkQueryPoolCreateInfo _pool_info = {
+                        .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+                        .pNext = nullptr,
+                        .flags = 0,
+                        .queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS,
+                        .queryCount = frames,
+                        .pipelineStatistics = _STATISTICS[i]
+                    };
+
+                VK_TRY(vkCreateQueryPool(*_device, &_pool_info, HOST_ALLOCATOR, &_pools[i]));
+                REGISTER_OBJECT(VK_OBJECT_TYPE_QUERY_POOL, _pools[i], 0);
+                _pending[i].assign(frames, 0);
+                _recorded[i].assign(frames, 0);
+            }
+
+        return;
+    }
+
+void PipelineStatistics::destroy()
+    {
+        if (!enabled()) { return; }
+
+        report(LOGGER::VLINE, "\t .. Destroying Pipeline Statistics ..");
+
+        for (uint32_t i = 0; i < 2; i++)
+            {
+                RELEASE_OBJECT(VK_OBJECT_TYPE_QUERY_POOL, _pools[i]);
+                vkDestroyQueryPool(*_device, _pools[i], HOST_ALLOCATOR);
+                _pools[i] = VK_NULL_HANDLE;
+            }
+
+        return;
+    }
+
+
+    /////////////
+    // QUERIES //
+    /////////////
+
+// Not allowed inside a render pass, so the graphics query is reset before the pass it begins in
+void PipelineStatistics::reset(VkCommandBuffer command_buffer, uint32_t frame, PIPELINE_QUERY half)
+    {
+        if (!enabled()) { return; }
+
+        vkCmdResetQueryPool(command_buffer, _pools[half], frame, 1);
+
+        return;
+    }
+
+void PipelineStatistics::begin(VkCommandBuffer command_buffer, uint32_t frame, PIPELINE_QUERY half)
+    {
+        if (!enabled()) { return; }
+
+        vkCmdBeginQuery(command_buffer, _pools[half], frame, 0);
+
+        return;
+    }
+
+void PipelineStatistics::end(VkCommandBuffer command_buffer, uint32_t frame, PIPELINE_QUERY half)
+    {
+        if (!enabled()) { return; }
+
+        vkCmdEndQuery(command_buffer, _pools[half], frame);
+        _pending[half][frame] = 1;
+        _recorded[half][frame] = _expected;
+
+        return;
+    }
+
+// After the frame's fences have signaled. A query recorded but never submitted reads as not ready
+// and is dropped along with its pending flag, the slot's next recording starts it over.
+void PipelineStatistics::collect(uint32_t frame)
+    {
+        if (!enabled()) { return; }
+
+        uint64_t _counts[3];
+
+        if (_pending[QUERY_COMPUTE][frame])
+            {
+                _pending[QUERY_COMPUTE][frame] = 0;
+                VkResult _result = vkGetQueryPoolResults(*_device, _pools[QUERY_COMPUTE], frame, 1, sizeof(uint64_t), _counts, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+
+                if (_result == VK_SUCCESS)
+                    {
+                        _last.compute_invocations = _counts[0];
+                        _total.compute_invocations += _counts[0];
+                        _frames[QUERY_COMPUTE]++;
+                        _particles[QUERY_COMPUTE] += _recorded[QUERY_COMPUTE][frame];
+
+                        if (_counts[0] < _recorded[QUERY_COMPUTE][frame] && !_short_dispatch)
+                            {
+                                report(LOGGER::INFO, "PipelineStatistics - Dispatch Ran %llu Compute Invocations for %llu Particles ..",
+                                        (unsigned long long)_counts[0], (unsigned long long)_recorded[QUERY_COMPUTE][frame]);
+                                _short_dispatch = true;
+                            }
+                    }
+            }
+
+        if (_pending[QUERY_GRAPHICS][frame])
+            {
+                _pending[QUERY_GRAPHICS][frame] = 0;
+                VkResult _result = vkGetQueryPoolResults(*_device, _pools[QUERY_GRAPHICS], frame, 1, sizeof(_counts), _counts, sizeof(_counts), VK_QUERY_RESULT_64_BIT);
+
+                if (_result == VK_SUCCESS)
+                    {
+                        _last.vertex_invocations = _counts[0];
+                        _last.clipping_primitives = _counts[1];
+                        _last.fragment_invocations = _counts[2];
+                        _total.vertex_invocations += _counts[0];
+                        _total.clipping_primitives += _counts[1];
+                        _total.fragment_invocations += _counts[2];
+                        _frames[QUERY_GRAPHICS]++;
+                        _particles[QUERY_GRAPHICS] += _recorded[QUERY_GRAPHICS][frame];
+                    }
+            }
+
+        return;
+    }
+
+
+    /////////
+    // LOG //
+    /////////
+
+// Averages since start up. Every particle is one point, so fragments per particle is the sprite overdraw.
+void PipelineStatistics::log()
+    {
+        if (!enabled() || _frames[QUERY_COMPUTE] + _frames[QUERY_GRAPHICS] == 0) { return; }
+
+        double _compute_frames = _frames[QUERY_COMPUTE] ? (double)_frames[QUERY_COMPUTE] : 1.0;
+        double _graphics_frames = _frames[QUERY_GRAPHICS] ? (double)_frames[QUERY_GRAPHICS] : 1.0;
+        double _compute_particles = _particles[QUERY_COMPUTE] ? (double)_particles[QUERY_COMPUTE] : 1.0;
+        double _graphics_particles = _particles[QUERY_GRAPHICS] ? (double)_particles[QUERY_GRAPHICS] : 1.0;
+
+        // Per particle against what each frame expected, the particle count may have been set midway
+        report(LOGGER::INFO, "PipelineStatistics - Average per Frame for %.0f Particles ..", _graphics_particles / _graphics_frames);
+        report(LOGGER::ILINE, "\tCompute Invocations:  %14.0f  (%.3f per particle)",
+                _total.compute_invocations / _compute_frames, _total.compute_invocations / _compute_particles);
+        report(LOGGER::ILINE, "\tVertex Invocations:   %14.0f  (%.3f per particle)",
+                _total.vertex_invocations / _graphics_frames, _total.vertex_invocations / _graphics_particles);
+        report(LOGGER::ILINE, "\tClipped Primitives:   %14.0f  (%.3f per particle)",
+                _total.clipping_primitives / _graphics_frames, _total.clipping_primitives / _graphics_particles);
+        report(LOGGER::ILINE, "\tFragment Invocations: %14.0f  (%.3f per particle)",
+                _total.fragment_invocations / _graphics_frames, _total.fragment_invocations / _graphics_particles);
+
+        return;
+    }
@@ -0,0 +1,59 @@
+#pragma once
+#include "../00atomic/atomic.h"
+
+#include <vector>
+
+// Which half of the frame a query counts, each has its own pool since a compute-only
+// queue can't begin a query that includes graphics statistics
+enum PIPELINE_QUERY {
+    QUERY_COMPUTE,
+    QUERY_GRAPHICS
+};
+
+// One frame's counts, in the order Vulkan writes them (ascending statistic bit)
+struct PipelineCounts
+    {
+        uint64_t vertex_invocations;
+        uint64_t clipping_primitives;
+        uint64_t fragment_invocations;
+        uint64_t compute_invocations;
+    };
+
+/*
+    PipelineStatistics counts what the particle dispatch and draw actually ran: compute invocations,
+    vertex invocations, primitives out of clipping and fragment invocations. Every frame in flight has
+    one query per half, read back like the GPU timestamps once the slot's fences have signaled and never
+    waited on. The counts are held against the particles expected, a dispatch that runs fewer compute
+    invocations than there are particles is reported once, and log() gives the fragments per particle.
+    reset() has to be recorded outside a render pass, so the graphics query can begin inside one.
+*/
+
+class PipelineStatistics {
+    public:
+        PipelineStatistics();
+        ~PipelineStatistics();
+
+        void init(VkDevice*, uint32_t, uint64_t);
+        void expect(uint64_t expected) { _expected = expected; _short_dispatch = false; }
+        void destroy();
+        bool enabled() { return _pools[QUERY_COMPUTE] != VK_NULL_HANDLE; }
+
+        void reset(VkCommandBuffer, uint32_t, PIPELINE_QUERY);
+        void begin(VkCommandBuffer, uint32_t, PIPELINE_QUERY);
+        void end(VkCommandBuffer, uint32_t, PIPELINE_QUERY);
+        void collect(uint32_t);
+        PipelineCounts last() { return _last; }
+        void log();
+
+    private:
+        VkDevice* _device;
+        VkQueryPool _pools[2];
+        std::vector<uint8_t> _pending[2];       // per frame, the query was ended and not yet read
+        std::vector<uint64_t> _recorded[2];     // per frame, what was expected when the query was recorded
+        uint64_t _expected;                     // compute and vertex invocations one frame should run
+        bool _short_dispatch;                   // reported already
+        PipelineCounts _last;
+        PipelineCounts _total;
+        uint64_t _frames[2];                    // frames summed into _total, per half
+        uint64_t _particles[2];                 // what those frames expected, summed, so a count set midway averages right
+};
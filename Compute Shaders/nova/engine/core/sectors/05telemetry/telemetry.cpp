@@ -0,0 +1,79 @@
+#include "../../core.h"
+
+#include <algorithm>
+
+    //////////////////
+    // GPU PROFILER //
+    //////////////////
+
+// Traces need both clocks in VK_EXT_calibrated_timestamps, the device's and CLOCK_MONOTONIC
+static PFN_vkGetCalibratedTimestampsEXT _getCalibration(VkInstance instance, VkPhysicalDevice physical_device, VkDevice logical_device)
+    {
+        auto _getDomains = (PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceCalibrateableTimeDomainsEXT");
+        if (_getDomains == nullptr) { return nullptr; }
+
+        uint32_t _domain_ct = 0;
+        _getDomains(physical_device, &_domain_ct, nullptr);
+        std::vector<VkTimeDomainEXT> _domains(_domain_ct);
+        _getDomains(physical_device, &_domain_ct, _domains.data());
+
+        bool _device_clock = std::find(_domains.begin(), _domains.end(), VK_TIME_DOMAIN_DEVICE_EXT) != _domains.end();
+        bool _host_clock = std::find(_domains.begin(), _domains.end(), VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT) != _domains.end();
+        if (!_device_clock || !_host_clock) { return nullptr; }
+
+        return (PFN_vkGetCalibratedTimestampsEXT)vkGetDeviceProcAddr(logical_device, "vkGetCalibratedTimestampsEXT");
+    }
+
+// Runs ahead of the swapchain, which reads whether dynamic resolution survived
+void NovaCore::createGpuProfiler()
+    {
+        STARTUP_STAGE();
+
+        if (!config.gpu_profiling && !config.dynamic_resolution && config.trace_path == nullptr) { return; }
+
+        gpu_profiler.init(&logical_device, physical_device, MAX_FRAMES_IN_FLIGHT);
+
+        if (config.dynamic_resolution && !gpu_profiler.timed(queues.indices.graphics_family.value()))
+            {
+                report(LOGGER::INFO, "NovaCore - Graphics Queue Has No Timestamps, Disabling Dynamic Resolution ..");
+                config.dynamic_resolution = false;
+            }
+
+        if (config.trace_path == nullptr) { return; }
+
+        PFN_vkGetCalibratedTimestampsEXT _calibration = nullptr;
+        if (device_features.enabled(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME))
+            { _calibration = _getCalibration(instance, physical_device, logical_device); }
+
+        if (_calibration == nullptr)
+            {
+                report(LOGGER::INFO, "NovaCore - Timestamps Can't Be Calibrated, Tracing the CPU Only ..");
+                return;
+            }
+
+        gpu_profiler.calibrate(_calibration);
+
+        uint32_t _graphics = queues.indices.graphics_family.value();
+        uint32_t _compute = queues.indices.compute_family.value();
+        TraceRecorder::get().nameTrack(TraceRecorder::gpuTrack(_graphics), _graphics == _compute ? "GPU Graphics + Compute" : "GPU Graphics");
+        if (_graphics != _compute) { TraceRecorder::get().nameTrack(TraceRecorder::gpuTrack(_compute), "GPU Compute"); }
+
+        return;
+    }
+
+
+    /////////////////////////
+    // PIPELINE STATISTICS //
+    /////////////////////////
+
+// The device feature was settled in queryDeviceFeatures, every particle should get one compute and one vertex invocation
+void NovaCore::createPipelineStatistics()
+    {
+        STARTUP_STAGE();
+
+        if (!config.pipeline_statistics) { return; }
+
+        pipeline_statistics.init(&logical_device, MAX_FRAMES_IN_FLIGHT, config.particle_count);
+
+        return;
+    }
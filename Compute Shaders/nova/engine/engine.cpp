@@ -11,93 +11,102 @@
     ///////////////////
 
 
-NovaEngine::NovaEngine(std::string name, VkExtent2D window_extent)
+NovaEngine::NovaEngine(std::string name, VkExtent2D window_extent, EngineConfig config)
     {
         report(LOGGER::INFO, "NovaEngine - Instantiating ..");
 
         // Set the application name and window extent
         _application_name = name;
         _window_extent = window_extent;
-        
-        // Initialize SDL and create a window
-        SDL_Init(SDL_INIT_VIDEO);
-        SDL_WindowFlags window_flags = (SDL_WindowFlags)(SDL_WINDOW_VULKAN | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
-
-        _window = SDL_CreateWindow(
-            name.c_str(),
-            SDL_WINDOWPOS_UNDEFINED,
-            SDL_WINDOWPOS_UNDEFINED,
-            _window_extent.width,
-            _window_extent.height,
-            window_flags
-        );
-
-        if (_window == nullptr) 
+        _config = config;
+
+        if (_config.trace_path != nullptr)
             {
-                report(LOGGER::ERROR, "NovaEngine - Failed to create SDL window ..");
-                return;
+                TraceRecorder::get().configure(_config.trace_path, _config.trace_first_frame, _config.trace_frames);
+                TraceRecorder::get().nameThread("Render");
             }
 
+        // Ahead of the instance, every object has to be destroyed with the callbacks it was created with
+        HostAllocator::get().configure(_config.host_allocator);
+        
+        // Initialize SDL and create a window, headless only needs the timer
+        if (_config.headless)
+            { SDL_Init(SDL_INIT_TIMER); }
+        else
+            {
+                StartupTimer _window_stage("SDL_CreateWindow");
+                SDL_Init(SDL_INIT_VIDEO);
+                SDL_WindowFlags window_flags = (SDL_WindowFlags)(SDL_WINDOW_VULKAN | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
+
+                _window = SDL_CreateWindow(
+                    name.c_str(),
+                    SDL_WINDOWPOS_UNDEFINED,
+                    SDL_WINDOWPOS_UNDEFINED,
+                    _window_extent.width,
+                    _window_extent.height,
+                    window_flags
+                );
+
+                if (_window == nullptr) 
+                    {
+                        report(LOGGER::ERROR, "NovaEngine - Failed to create SDL window ..");
+                        return;
+                    }
+            }
 
-        // TODO: Wrap all of this into a subset of init functions 
-        //       that use proper fences and semaphores with the following order:
-        // Device()
-        // Presentation()
-        // Management()
-        // Scene()
-        // Render()
-
-        _architect = new NovaCore(_window_extent);
-        _initFramework(); // Do we want to handle this in the NovaCore?
 
-        
-        // Now we can construct the Swapchain
-        std::promise<void> waitForSwapchain;
-        std::future<void> waitingForFrameBuffer = waitForSwapchain.get_future();
-        std::promise<void> startPipeline;
-        std::future<void> startingPipeline = startPipeline.get_future();
-        std::promise<void> waitForPipeline; 
-        std::future<void> waitingForPipeline = waitForPipeline.get_future();
+        _architect = new NovaCore(_window_extent, _config);
 
-        std::thread _swapchain_thread(&NovaEngine::_initSwapChain, this, std::ref(startPipeline), std::ref(waitingForPipeline), std::ref(waitForSwapchain));
-        std::thread _pipeline_thread(&NovaEngine::_initPipeline, this, std::ref(startingPipeline), std::ref(waitForPipeline));
+        // SDL wants the window's surface made on the thread that owns the window
+        if (!_config.headless)
+            { 
+                StartupTimer _surface_stage("SDL_Vulkan_CreateSurface");
+                SDL_Vulkan_CreateSurface(_window, _architect->instance, &_architect->surface); 
+                REGISTER_OBJECT(VK_OBJECT_TYPE_SURFACE_KHR, _architect->surface, 0);
+            }
 
-        _pipeline_thread.join();
-        _swapchain_thread.join();
-        waitingForFrameBuffer.wait();
+        TaskGraph _init;
+        _initTasks(_init);
+        _init.run();
+        _init.log();
 
+        if (_config.control_path != nullptr)
+            {
+                NovaCore* _core = _architect;
+                _control.open(_config.control_path, [_core](const char* line, std::string& reply) { _core->control(line, reply); });
+            }
 
-        // Now we can construct the Command Buffers 
-        _initBuffers();
-        _initSyncStructures();
         report(LOGGER::INFO, "NovaEngine - Initialized ..");
     }
 
 NovaEngine::~NovaEngine() 
     {
         report(LOGGER::INFO, "NovaEngine - Deconstructing ..");
+        _control.close();
         vkDeviceWaitIdle(_architect->logical_device);
 
         if (USE_VALIDATION_LAYERS) 
             { 
                 report(LOGGER::VLINE, "\t .. Destroying Debug Messenger ..");
-                destroyDebugUtilsMessengerEXT(_architect->instance, _debug_messenger, nullptr); 
+                destroyDebugUtilsMessengerEXT(_architect->instance, _debug_messenger, HOST_ALLOCATOR); 
             }
 
+        report(LOGGER::VLINE, "\t .. Destroying NovaCore ..");
+        delete _architect;
+        _architect = nullptr;
+
         if (initialized) 
             {         
-                report(LOGGER::VLINE, "\t .. Destroying NovaCore ..");
-                delete _architect;
-
-                report(LOGGER::VLINE, "\t .. Destroying Window ..");
-                SDL_DestroyWindow(_window); 
+                if (_window != nullptr)
+                    {
+                        report(LOGGER::VLINE, "\t .. Destroying Window ..");
+                        SDL_DestroyWindow(_window); 
+                    }
 
                 SDL_Quit();
             }
         
         report(LOGGER::INFO, "NovaEngine - Destroyed ..");
-
-        delete _architect;
     }
 
 
@@ -112,14 +121,29 @@ void NovaEngine::illuminate()
 
         SDL_Event _e;
         bool _quit = false;
+        uint64_t _frames = 0;
 
         while (!_quit) {
+            TRACE_SCOPE("illuminate");
+
             while (SDL_PollEvent(&_e)) 
                 {
                     if (_e.type == SDL_QUIT) { _quit = !_quit; }
                     
                     if (_e.type == SDL_KEYDOWN) 
-                        { if (_e.key.keysym.sym == SDLK_ESCAPE) { _quit = !_quit; } }
+                        { 
+                            switch (_e.key.keysym.sym)
+                                {
+                                    case SDLK_ESCAPE: _quit = !_quit; break;
+                                    case SDLK_b: _toggleBlendMode(); break;
+                                    case SDLK_c: _toggleCullMode(); break;
+                                    case SDLK_q: _toggleParticleShape(); break;
+                                    case SDLK_p: _cyclePresentPolicy(); break;
+                                    case SDLK_g: _architect->gpu_profiler.log(); _architect->pipeline_statistics.log(); break;
+                                    case SDLK_o: ObjectRegistry::get().log(); break;
+                                    case SDLK_h: _architect->toggleHud(); break;
+                                }
+                        }
 
                     if (_e.type == SDL_WINDOWEVENT) 
                         { 
@@ -132,6 +156,9 @@ void NovaEngine::illuminate()
                         }
 
                 }
+
+            // Between frames, so whatever a command changes is in place before the next one is recorded
+            _control.poll();
             
             if (_suspended) 
                 {
@@ -141,6 +168,10 @@ void NovaEngine::illuminate()
             else 
                 { _architect->drawFrame(); }
 
+            // Headless runs have no window to close, the frame limit is how they end
+            if (_config.frame_limit && ++_frames >= _config.frame_limit)
+                { _quit = true; }
+
             //fnManifest();
         }
 
@@ -154,9 +185,10 @@ void NovaEngine::illuminate()
 
 void NovaEngine::_initFramework() 
     {
+        STARTUP_STAGE();
+
         report(LOGGER::INFO, "NovaEngine - Initializing Frameworks ..");
 
-        SDL_Vulkan_CreateSurface(_window, _architect->instance, &_architect->surface);
         createDebugMessenger(&_architect->instance, &_debug_messenger);
         _architect->createPhysicalDevice();
         _architect->createLogicalDevice();
@@ -164,67 +196,48 @@ void NovaEngine::_initFramework()
         return;
     }
 
-void NovaEngine::_initSwapChain(std::promise<void>& startPipeline, std::future<void>& waitingForPipeline, std::promise<void>& waitForFrameBuffer) 
+// Each task only touches what its dependencies have finished with. The swapchain goes first wherever
+// it's named since it settles the surface format and turns capture or dynamic resolution off when unsupported,
+// with the GPU profiler ahead of it for the timestamp half of that.
+void NovaEngine::_initTasks(TaskGraph& graph)
     {
-        report(LOGGER::INFO, "NovaEngine - Initializing SwapChain Buffers ..");
-
-        _architect->constructSwapChain();
-        _architect->constructImageViews();
-        startPipeline.set_value();
-        waitingForPipeline.wait();
-        _architect->createCommandPool(); 
-        //_architect->createColorResources();
-        //_architect->createDepthResources();
-        _architect->createFrameBuffers();
-        waitForFrameBuffer.set_value();
-     
-        return;
-    }
-
-void NovaEngine::_initPipeline(std::future<void>& startingPipeline, std::promise<void>& waitForPipeline) 
-    {
-        report(LOGGER::INFO, "NovaEngine - Initializing Nova Pipeline ..");
-
-        // abstract both of these as part of the NovaCore and rename _architect to NovaCore
-
-        startingPipeline.wait();
-        _architect->createRenderPass();
-        _architect->createComputeDescriptorSetLayout();
-//        _architect->createDescriptorSetLayout();
-        _architect->constructGraphicsPipeline();
-        _architect->constructComputePipeline();
-        waitForPipeline.set_value();
-     
-        return;
-    }
-
-void NovaEngine::_initBuffers() 
-    {
-        report(LOGGER::INFO, "NovaEngine - Initializing Command Operator ..");
-
-        //_architect->createTextureImage();
-        //_architect->createTextureImageView();
-        //_architect->constructTextureSampler();
-        // TODO: Combine Object Phases
-        //_architect->constructVertexBuffer();
-        //_architect->constructIndexBuffer(); 
-        // TODO: multithread UBO into the Presentation Phase
-        _architect->constructStorageBuffers();
-        _architect->constructUniformBuffer(); 
-        // TODO: multithread Command Buffer to init as part of the Management Phase
-        _architect->constructDescriptorPool();
-        _architect->createComputeDescriptorSets();
-        //_architect->createDescriptorSets();
-        _architect->createCommandBuffers();
-     
-        return;
-    }
-
-void NovaEngine::_initSyncStructures()
-    {
-        report(LOGGER::INFO, "NovaEngine - Initializing Synchronization Structures ..");
-
-        _architect->createSyncObjects();
+        report(LOGGER::INFO, "NovaEngine - Building Initialization Graph ..");
+
+        NovaCore* _core = _architect;
+
+        uint32_t _particles = graph.add("Particles", [_core] { _core->generateParticles(); });
+        uint32_t _framework = graph.add("Framework", [this] { _initFramework(); });
+
+        // Presentation
+        uint32_t _profiler = graph.add("GPU Profiler", [_core] { _core->createGpuProfiler(); }, { _framework });
+        uint32_t _swapchain = graph.add("SwapChain", [_core] {
+                _core->constructSwapChain();
+                _core->constructImageViews();
+                _core->createRenderTargets();
+            }, { _profiler });
+        uint32_t _render_pass = graph.add("Render Pass", [_core] { _core->createRenderPass(); }, { _swapchain });
+        graph.add("Frame Buffers", [_core] { _core->createFrameBuffers(); }, { _render_pass });
+
+        // Pipelines
+        uint32_t _layouts = graph.add("Descriptor Layouts", [_core] {
+                _core->createComputeDescriptorSetLayout();
+                _core->createBindlessTable();
+            }, { _framework });
+        graph.add("Graphics Pipeline", [_core] { _core->constructGraphicsPipeline(); }, { _render_pass });
+        graph.add("Compute Pipeline", [_core] { _core->constructComputePipeline(); }, { _layouts });
+        graph.add("HUD", [_core] { _core->createHud(); }, { _render_pass });
+
+        // Buffers
+        uint32_t _pools = graph.add("Command Pools", [_core] { _core->createCommandPool(); }, { _framework });
+        uint32_t _storage = graph.add("Storage Buffers", [_core] { _core->constructStorageBuffers(); }, { _particles, _pools });
+        uint32_t _descriptor_pool = graph.add("Descriptor Pool", [_core] { _core->constructDescriptorPool(); }, { _framework });
+        graph.add("Descriptor Sets", [_core] { _core->createComputeDescriptorSets(); }, { _storage, _layouts, _descriptor_pool });
+        graph.add("Command Buffers", [_core] { _core->createCommandBuffers(); }, { _pools });
+        graph.add("Pipeline Statistics", [_core] { _core->createPipelineStatistics(); }, { _framework });
+        graph.add("Capture Ring", [_core] { _core->createCaptureRing(); }, { _swapchain });
+
+        // Synchronization
+        graph.add("Sync Objects", [_core] { _core->createSyncObjects(); }, { _framework });
 
         return;
     }
@@ -250,3 +263,44 @@ inline void NovaEngine::_resizeWindow()
         return;
     }   
 
+
+
+    //////////////////
+    // RENDER MODES //
+    //////////////////
+
+// Switched through extended dynamic state, so these never rebuild a pipeline
+inline void NovaEngine::_toggleBlendMode()
+    {
+        _render_state.blend = _render_state.blend == BLEND_ALPHA ? BLEND_ADDITIVE : BLEND_ALPHA;
+        report(LOGGER::VERBOSE, "NovaEngine - Blend Mode: %s ..", _render_state.blend == BLEND_ALPHA ? "Alpha" : "Additive");
+        _architect->setRenderState(_render_state);
+        return;
+    }
+
+inline void NovaEngine::_toggleCullMode()
+    {
+        _render_state.cull_mode = _render_state.cull_mode == VK_CULL_MODE_NONE ? VK_CULL_MODE_BACK_BIT : VK_CULL_MODE_NONE;
+        report(LOGGER::VERBOSE, "NovaEngine - Cull Mode: %s ..", string_VkCullModeFlags(_render_state.cull_mode).c_str());
+        _architect->setRenderState(_render_state);
+        return;
+    }
+
+// Points to quads crosses a topology class, so it only switches on devices with unrestricted dynamic topology
+inline void NovaEngine::_toggleParticleShape()
+    {
+        bool _points = _render_state.topology == VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
+        _render_state.topology = _points ? VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST : VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
+        report(LOGGER::VERBOSE, "NovaEngine - Particle Shape: %s ..", _points ? "Quads" : "Points");
+        _architect->setRenderState(_render_state);
+        return;
+    }
+
+// Recreates the swapchain, the mode reported is what the surface settled on rather than what was asked for
+inline void NovaEngine::_cyclePresentPolicy()
+    {
+        PRESENT_POLICY _policy = (PRESENT_POLICY)((_architect->config.present_policy + 1) % (PRESENT_UNCAPPED + 1));
+        VkPresentModeKHR _mode = _architect->setPresentPolicy(_policy);
+        report(LOGGER::INFO, "NovaEngine - Present Policy: %s (%s) ..", PRESENT_POLICY_NAMES[_policy], string_VkPresentModeKHR(_mode));
+        return;
+    }
@@ -1,8 +1,8 @@
 #pragma once
 #include "./core/core.h"
+#include "./core/components/utility/task_graph.h"
 
 #include <string>
-#include <future>
 
 // The goal of this layer of abstraction is to create a friendly user implementation for creating a graphics engine, for future projects.
 
@@ -11,7 +11,7 @@ class NovaEngine {
     public:
         bool initialized = false;
 
-        NovaEngine(std::string, VkExtent2D);
+        NovaEngine(std::string, VkExtent2D, EngineConfig = {});
         ~NovaEngine();
 
         // TODO: Determine Default Initializers 
@@ -24,15 +24,19 @@ class NovaEngine {
         std::string _application_name;
         bool _suspended = false;
         VkExtent2D _window_extent;
+        EngineConfig _config;
+        RenderState _render_state;
         struct SDL_Window* _window = nullptr;
         NovaCore* _architect;
+        ControlSocket _control;                 // live statistics and tuning, polled between frames
 
         VkDebugUtilsMessengerEXT _debug_messenger;
 
         void _initFramework();
-        void _initSwapChain(std::promise<void>&, std::future<void>&, std::promise<void>&);
-        void _initPipeline(std::future<void>&, std::promise<void>&);
-        void _initBuffers();
-        void _initSyncStructures();
+        void _initTasks(TaskGraph&);
         void _resizeWindow();
+        void _toggleBlendMode();
+        void _toggleCullMode();
+        void _toggleParticleShape();
+        void _cyclePresentPolicy();
 };
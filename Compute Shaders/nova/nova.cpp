@@ -1,15 +1,128 @@
 #include "nova.h"
 
+#include <cstdlib>
+#include <cstring>
+
  Nova* _essence = nullptr;
 
  Nova:: Nova() 
     {
+        StartupProfiler::get();     // starts the clock the startup report measures from
+
+        // A y4m capture to "-" has stdout to itself, so the log moves to stderr before the first line
+        const char* _capture_format = std::getenv("NOVA_CAPTURE_FORMAT");
+        const char* _capture_path = std::getenv("NOVA_CAPTURE_PATH");
+        if (std::getenv("NOVA_CAPTURE") && _capture_format && _capture_path && strcmp(_capture_format, "y4m") == 0 && strcmp(_capture_path, "-") == 0)
+            { setLogStream(stderr); }
+
         report(LOGGER::INFO, " Nova - Constructing Nova ..");
         assert(_essence == nullptr);
         
         _application_name = "Compute Shaders";
         _window_extent = { 1600, 1200 };
+        _config = {};
         _engine = nullptr;
+
+        // NOVA_HEADLESS=<frames> renders offscreen for that many frames, for CI and the render farm
+        if (const char* _headless = std::getenv("NOVA_HEADLESS"))
+            {
+                _config.headless = true;
+                _config.frame_limit = std::strtoull(_headless, nullptr, 10);
+            }
+
+        // NOVA_FRAME_LIMIT=<frames> ends a windowed run too, for benchmarking the present policies
+        if (const char* _frame_limit = std::getenv("NOVA_FRAME_LIMIT"))
+            { _config.frame_limit = std::strtoull(_frame_limit, nullptr, 10); }
+
+        // NOVA_CAPTURE=<N> writes every Nth frame, NOVA_CAPTURE_FORMAT picks raw, ppm, png or y4m
+        if (const char* _capture = std::getenv("NOVA_CAPTURE"))
+            {
+                static const char* _FORMATS[] = { "raw", "ppm", "png", "y4m" };
+                const char* _format = std::getenv("NOVA_CAPTURE_FORMAT");
+                const char* _path = std::getenv("NOVA_CAPTURE_PATH");
+
+                _config.capture_interval = std::strtoul(_capture, nullptr, 10);
+
+                for (int i = 0; _format && i <= CAPTURE_Y4M; i++)
+                    { if (strcmp(_format, _FORMATS[i]) == 0) { _config.capture_format = (CAPTURE_FORMAT)i; } }
+
+                if (_path) { _config.capture_path = _path; }
+            }
+
+        // NOVA_FRAME_BUDGET=<ms> scales the render resolution to keep GPU time under the budget
+        if (const char* _budget = std::getenv("NOVA_FRAME_BUDGET"))
+            {
+                _config.dynamic_resolution = true;
+                _config.frame_budget_ms = std::strtof(_budget, nullptr);
+            }
+
+        // NOVA_STARTUP_REPORT=<path> writes the startup timings as JSON instead of logging them
+        if (const char* _startup_report = std::getenv("NOVA_STARTUP_REPORT"))
+            { _config.startup_report = _startup_report; }
+
+        // NOVA_PIPELINE_STATS=1 counts the dispatch's and the draw's shader invocations, logged on exit
+        if (const char* _pipeline_stats = std::getenv("NOVA_PIPELINE_STATS"))
+            { _config.pipeline_statistics = std::strtoul(_pipeline_stats, nullptr, 10) != 0; }
+
+        // NOVA_CONTROL=<path> listens on a Unix socket for stats, get and set commands, one per line
+        if (const char* _control = std::getenv("NOVA_CONTROL"))
+            { _config.control_path = _control; }
+
+        // NOVA_HUD=1 draws the performance overlay over the particles, H toggles it
+        if (const char* _hud = std::getenv("NOVA_HUD"))
+            { _config.hud = std::strtoul(_hud, nullptr, 10) != 0; }
+
+        // NOVA_FRAME_STATS=<seconds> between frame time summaries, 0 leaves only the one on exit
+        if (const char* _frame_stats = std::getenv("NOVA_FRAME_STATS"))
+            { _config.frame_stats_interval = std::strtod(_frame_stats, nullptr); }
+
+        // NOVA_PARTICLES and NOVA_WORKGROUP_SIZE size the simulation and its dispatch
+        if (const char* _particles = std::getenv("NOVA_PARTICLES"))
+            { _config.particle_count = std::strtoul(_particles, nullptr, 10); }
+
+        if (const char* _workgroup_size = std::getenv("NOVA_WORKGROUP_SIZE"))
+            { _config.workgroup_size = std::strtoul(_workgroup_size, nullptr, 10); }
+
+        // NOVA_SUBSTEPS=<N> integrates the orbit in N steps per dispatch
+        if (const char* _substeps = std::getenv("NOVA_SUBSTEPS"))
+            { _config.substeps = std::strtoul(_substeps, nullptr, 10); }
+
+        // NOVA_PRESENT_POLICY picks latency, throughput, power_save or uncapped
+        if (const char* _policy = std::getenv("NOVA_PRESENT_POLICY"))
+            {
+                for (int i = 0; i <= PRESENT_UNCAPPED; i++)
+                    { if (strcmp(_policy, PRESENT_POLICY_KEYS[i]) == 0) { _config.present_policy = (PRESENT_POLICY)i; } }
+            }
+
+        // NOVA_BENCH=<prefix> appends this run's results to <prefix>.jsonl and <prefix>.csv,
+        // leaving out the first NOVA_BENCH_WARMUP frames
+        if (const char* _bench = std::getenv("NOVA_BENCH"))
+            {
+                _config.bench_path = _bench;
+
+                if (const char* _warmup = std::getenv("NOVA_BENCH_WARMUP"))
+                    { _config.bench_warmup = std::strtoull(_warmup, nullptr, 10); }
+            }
+
+        // NOVA_HOST_ALLOCATOR=track counts the driver's host allocations, pool also serves them from a pool
+        if (const char* _host_allocator = std::getenv("NOVA_HOST_ALLOCATOR"))
+            {
+                if (strcmp(_host_allocator, "track") == 0) { _config.host_allocator = HOST_ALLOCATOR_TRACK; }
+                else if (strcmp(_host_allocator, "pool") == 0) { _config.host_allocator = HOST_ALLOCATOR_POOL; }
+            }
+
+        // NOVA_TRACE=<path> writes a Chrome trace, NOVA_TRACE_FRAMES=<first>:<count> picks the window
+        if (const char* _trace = std::getenv("NOVA_TRACE"))
+            {
+                _config.trace_path = _trace;
+
+                if (const char* _window = std::getenv("NOVA_TRACE_FRAMES"))
+                    {
+                        char* _end;
+                        _config.trace_first_frame = std::strtoull(_window, &_end, 10);
+                        if (*_end == ':') { _config.trace_frames = std::strtoull(_end + 1, nullptr, 10); }
+                    }
+            }
     }
 
  Nova::~ Nova()
@@ -41,7 +154,7 @@
         // Initialize the Graphics with Genesis 
         report(LOGGER::INFO, " Nova - Engine Realizing ..");
 
-        _engine = new NovaEngine(_application_name, _window_extent);
+        _engine = new NovaEngine(_application_name, _window_extent, _config);
         _engine->initialized = true;
 
         return this;
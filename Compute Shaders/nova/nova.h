@@ -15,6 +15,7 @@ class  Nova {
     private:
         std::string _application_name;
         VkExtent2D _window_extent;
+        EngineConfig _config;
         NovaEngine* _engine;
 
          Nova* realize();            // Init